@@ -31,6 +31,8 @@ public:
     const glm::mat4& GetViewMatrix() const { return viewMatrix; }
     const glm::mat4& GetProjectionMatrix() const { return projectionMatrix; }
 
+    std::array<glm::vec4, 6> GetFrustumPlanes() const;
+
     void UpdateViewMatrix();
     void UpdateProjectionMatrix();
 
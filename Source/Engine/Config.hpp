@@ -13,6 +13,13 @@ namespace Config
         eRayQueries
     };
 
+    enum class TextureCompression
+    {
+        eNone,
+        eBC1BC3,
+        eBC7
+    };
+
     constexpr const char* kEngineName = "SteelEngine";
 
     constexpr vk::Extent2D kExtent(1280, 720);
@@ -28,12 +35,42 @@ namespace Config
 
     constexpr bool kUseDefaultAssets = true;
 
+    constexpr bool kBenchmarkSceneImport = false;
+
+    constexpr bool kUseSceneCache = true;
+
+    constexpr TextureCompression kTextureCompression = TextureCompression::eBC7;
+
+    constexpr bool kOptimizeMeshes = true;
+
+    constexpr bool kMeshLods = true;
+
+    constexpr float kLodPixelError = 1.0f;
+
+    constexpr bool kMeshletCulling = true;
+
+    constexpr bool kFrustumCulling = true;
+
+    constexpr bool kGpuDrivenRendering = true;
+
+    constexpr bool kOcclusionCulling = true;
+
+    constexpr bool kStreamSceneTextures = true;
+
+    constexpr float kTextureStreamingTimeBudget = 0.004f;
+
     constexpr bool kStaticCamera = false;
 
     constexpr PathTracingMode kPathTracingMode = PathTracingMode::eRayTracing;
 
+    constexpr bool kEnvironmentSampling = true;
+
+    constexpr bool kCompactBlases = false;
+
     constexpr float kPointLightRadius = 0.05f;
 
+    constexpr bool kClusteredLighting = true;
+
     constexpr bool kReverseDepth = true;
 
     namespace DefaultCamera
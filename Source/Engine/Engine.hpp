@@ -42,8 +42,16 @@ public:
     static void AddEventHandler(EventType type, std::function<void(const T&)> handler);
 
 private:
+    struct LoadingState
+    {
+        Stopwatch stopwatch;
+        bool firstFrameDrawn = false;
+        bool fullyLoaded = false;
+    };
+
     static Timer timer;
     static State state;
+    static LoadingState loadingState;
 
     static std::unique_ptr<Window> window;
     static std::unique_ptr<FrameLoop> frameLoop;
@@ -61,6 +69,8 @@ private:
     template <class T, class ...Args>
     static void AddSystem(Args&&...args);
 
+    static void UpdateLoading();
+
     static void HandleResizeEvent(const vk::Extent2D& extent);
 
     static void HandleKeyInputEvent(const KeyInput& keyInput);
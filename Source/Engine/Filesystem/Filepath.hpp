@@ -20,6 +20,8 @@ public:
 
     bool Exists() const;
 
+    uint64_t GetLastWriteTime() const;
+
     bool Empty() const;
 
     bool IsDirectory() const;
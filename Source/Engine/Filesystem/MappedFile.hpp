@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Engine/Filesystem/Filepath.hpp"
+
+#include "Utils/DataHelpers.hpp"
+
+class MappedFile
+{
+public:
+    static std::unique_ptr<MappedFile> Create(const Filepath& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const ByteView& GetData() const { return data; }
+
+private:
+    ByteView data;
+
+    MappedFile(const ByteView& data_);
+};
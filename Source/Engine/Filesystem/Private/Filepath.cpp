@@ -59,6 +59,11 @@ bool Filepath::Exists() const
     return std::filesystem::exists(path);
 }
 
+uint64_t Filepath::GetLastWriteTime() const
+{
+    return static_cast<uint64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+}
+
 bool Filepath::Empty() const
 {
     return path.empty();
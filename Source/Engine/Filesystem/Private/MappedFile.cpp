@@ -0,0 +1,125 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Engine/Filesystem/MappedFile.hpp"
+
+#include "Utils/Logger.hpp"
+
+#ifdef _WIN32
+
+namespace Details
+{
+    static std::optional<ByteView> MapFile(const Filepath& filepath)
+    {
+        const HANDLE file = CreateFileA(filepath.GetAbsolute().c_str(), GENERIC_READ, FILE_SHARE_READ,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return std::nullopt;
+        }
+
+        LARGE_INTEGER fileSize;
+
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return std::nullopt;
+        }
+
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        CloseHandle(file);
+
+        if (mapping == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+        CloseHandle(mapping);
+
+        if (view == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        return ByteView(static_cast<const uint8_t*>(view), static_cast<size_t>(fileSize.QuadPart));
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    UnmapViewOfFile(data.data);
+}
+
+#else
+
+namespace Details
+{
+    static std::optional<ByteView> MapFile(const Filepath& filepath)
+    {
+        const int file = open(filepath.GetAbsolute().c_str(), O_RDONLY);
+
+        if (file < 0)
+        {
+            return std::nullopt;
+        }
+
+        struct stat fileStat;
+
+        if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+        {
+            close(file);
+            return std::nullopt;
+        }
+
+        const size_t fileSize = static_cast<size_t>(fileStat.st_size);
+
+        void* view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+
+        close(file);
+
+        if (view == MAP_FAILED)
+        {
+            return std::nullopt;
+        }
+
+        madvise(view, fileSize, MADV_WILLNEED);
+
+        return ByteView(static_cast<const uint8_t*>(view), fileSize);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    munmap(const_cast<uint8_t*>(data.data), data.size);
+}
+
+#endif
+
+std::unique_ptr<MappedFile> MappedFile::Create(const Filepath& filepath)
+{
+    const std::optional<ByteView> data = Details::MapFile(filepath);
+
+    if (!data.has_value())
+    {
+        LogW << "Failed to map file: " << filepath.GetAbsolute() << "\n";
+
+        return nullptr;
+    }
+
+    return std::unique_ptr<MappedFile>(new MappedFile(data.value()));
+}
+
+MappedFile::MappedFile(const ByteView& data_)
+    : data(data_)
+{}
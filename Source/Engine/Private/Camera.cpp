@@ -49,6 +49,27 @@ void Camera::SetZFar(float zFar)
     description.zFar = zFar;
 }
 
+std::array<glm::vec4, 6> Camera::GetFrustumPlanes() const
+{
+    const glm::mat4 viewProj = glm::transpose(projectionMatrix * viewMatrix);
+
+    std::array<glm::vec4, 6> planes{
+        viewProj[3] + viewProj[0],
+        viewProj[3] - viewProj[0],
+        viewProj[3] + viewProj[1],
+        viewProj[3] - viewProj[1],
+        viewProj[2],
+        viewProj[3] - viewProj[2]
+    };
+
+    for (auto& plane : planes)
+    {
+        plane /= glm::length(glm::vec3(plane));
+    }
+
+    return planes;
+}
+
 void Camera::UpdateViewMatrix()
 {
     viewMatrix = glm::lookAt(description.position, description.target, description.up);
@@ -14,6 +14,8 @@
 #include "Engine/Render/Renderer.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 
+#include "Utils/Logger.hpp"
+
 namespace Details
 {
     static Filepath GetScenePath()
@@ -26,7 +28,7 @@ namespace Details
         {
             const DialogDescription dialogDescription{
                 "Select Scene File", Filepath("~/"),
-                { "glTF Files", "*.gltf" }
+                { "glTF Files", "*.gltf *.glb" }
             };
 
             const std::optional<Filepath> scenePath = Filesystem::ShowOpenDialog(dialogDescription);
@@ -45,7 +47,7 @@ namespace Details
         {
             const DialogDescription dialogDescription{
                 "Select Environment File", Filepath("~/"),
-                { "Image Files", "*.hdr *.png" }
+                { "Image Files", "*.hdr *.png *.ktx2" }
             };
 
             const std::optional<Filepath> environmentPath = Filesystem::ShowOpenDialog(dialogDescription);
@@ -85,10 +87,24 @@ namespace Details
 
         return Format("Light color: %.2f %.2f %.2f", lightColor.r, lightColor.g, lightColor.b);
     }
+
+    static std::string GetCullingStatsText(const FrustumCulling::Stats& stats)
+    {
+        return Format("Frustum culling: %u / %u objects, %u / %u batches drawn (%.2f ms)",
+                stats.visibleObjectCount, stats.objectCount, stats.visibleBatchCount, stats.batchCount,
+                stats.cullingTime);
+    }
+
+    static std::string GetGpuCullingStatsText(const GBufferStage::GpuCullingStats& stats)
+    {
+        return Format("GPU culling: %u / %u draws, %u / %u batches drawn",
+                stats.visibleDrawCount, stats.drawCount, stats.visibleBatchCount, stats.batchCount);
+    }
 }
 
 Timer Engine::timer;
 Engine::State Engine::state;
+Engine::LoadingState Engine::loadingState;
 
 std::unique_ptr<Window> Engine::window;
 std::unique_ptr<FrameLoop> Engine::frameLoop;
@@ -105,6 +121,8 @@ std::map<EventType, std::vector<EventHandler>> Engine::eventMap;
 
 void Engine::Create()
 {
+    loadingState.stopwatch = Stopwatch();
+
     window = std::make_unique<Window>(Config::kExtent, Config::kWindowMode);
 
     VulkanContext::Create(*window);
@@ -133,6 +151,21 @@ void Engine::Create()
     GetSystem<UIRenderSystem>()->BindText([]() { return Details::GetCameraDirectionText(*camera); });
     GetSystem<UIRenderSystem>()->BindText([]() { return Details::GetLightDirectionText(*environment); });
     GetSystem<UIRenderSystem>()->BindText([]() { return Details::GetLightColorText(*environment); });
+
+    if constexpr (Config::kGpuDrivenRendering)
+    {
+        GetSystem<UIRenderSystem>()->BindText([]()
+            {
+                return Details::GetGpuCullingStatsText(GetSystem<RenderSystem>()->GetGpuCullingStats());
+            });
+    }
+    else if constexpr (Config::kFrustumCulling)
+    {
+        GetSystem<UIRenderSystem>()->BindText([]()
+            {
+                return Details::GetCullingStatsText(GetSystem<RenderSystem>()->GetCullingStats());
+            });
+    }
 }
 
 void Engine::Run()
@@ -164,6 +197,8 @@ void Engine::Run()
 
                 GetSystem<UIRenderSystem>()->Render(commandBuffer, imageIndex);
             });
+
+        UpdateLoading();
     }
 }
 
@@ -203,6 +238,28 @@ void Engine::AddEventHandler(EventType type, std::function<void()> handler)
         });
 }
 
+void Engine::UpdateLoading()
+{
+    if (loadingState.fullyLoaded)
+    {
+        return;
+    }
+
+    if (!loadingState.firstFrameDrawn)
+    {
+        loadingState.firstFrameDrawn = true;
+
+        LogI << Format("Time to first frame: %.2f ms", loadingState.stopwatch.GetElapsedMiliseconds()) << "\n";
+    }
+
+    loadingState.fullyLoaded = sceneModel->StreamTextures(*scene, *scenePT);
+
+    if (loadingState.fullyLoaded)
+    {
+        LogI << Format("Time to fully loaded: %.2f ms", loadingState.stopwatch.GetElapsedMiliseconds()) << "\n";
+    }
+}
+
 void Engine::HandleResizeEvent(const vk::Extent2D& extent)
 {
     VulkanContext::device->WaitIdle();
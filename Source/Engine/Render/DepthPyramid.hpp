@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
+#include "Engine/Render/Vulkan/DescriptorHelpers.hpp"
+
+class ComputePipeline;
+
+class DepthPyramid
+{
+public:
+    static constexpr vk::Format kFormat = vk::Format::eR32Sfloat;
+
+    DepthPyramid(vk::ImageView depthImageView);
+
+    ~DepthPyramid();
+
+    void Build(vk::CommandBuffer commandBuffer) const;
+
+    void Resize(vk::ImageView depthImageView);
+
+    void ReloadShaders();
+
+    vk::ImageView GetView() const { return texture.view; }
+
+private:
+    Texture texture;
+    vk::Extent2D extent;
+
+    std::vector<vk::ImageView> mipLevelViews;
+    std::vector<DescriptorSet> descriptorSets;
+
+    std::unique_ptr<ComputePipeline> pipeline;
+
+    void SetupTexture(vk::ImageView depthImageView);
+
+    void DestroyTexture();
+};
@@ -19,4 +19,6 @@ private:
 
     uint32_t frameIndex = 0;
     std::vector<Frame> frames;
+
+    std::vector<vk::Fence> imageFences;
 };
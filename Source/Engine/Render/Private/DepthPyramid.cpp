@@ -0,0 +1,223 @@
+#include "Engine/Render/DepthPyramid.hpp"
+
+#include "Engine/Render/Renderer.hpp"
+#include "Engine/Render/Vulkan/ComputeHelpers.hpp"
+#include "Engine/Render/Vulkan/ComputePipeline.hpp"
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
+#include "Engine/Config.hpp"
+
+namespace Details
+{
+    static constexpr glm::uvec2 kWorkGroupSize(8, 8);
+
+    static constexpr float kClearDepth = Config::kReverseDepth ? 0.0f : 1.0f;
+
+    static vk::Extent2D GetPyramidExtent(const vk::Extent2D& depthExtent)
+    {
+        return vk::Extent2D(std::max(depthExtent.width / 2, 1u), std::max(depthExtent.height / 2, 1u));
+    }
+
+    static std::unique_ptr<ComputePipeline> CreatePipeline(vk::DescriptorSetLayout descriptorSetLayout)
+    {
+        const std::map<std::string, uint32_t> defines{
+            { "REVERSE_DEPTH", static_cast<uint32_t>(Config::kReverseDepth) }
+        };
+
+        const std::tuple specializationValues = std::make_tuple(kWorkGroupSize.x, kWorkGroupSize.y);
+
+        const ShaderModule shaderModule = VulkanContext::shaderManager->CreateShaderModule(
+                vk::ShaderStageFlagBits::eCompute, Filepath("~/Shaders/Hybrid/DepthPyramid.comp"),
+                defines, specializationValues);
+
+        const vk::PushConstantRange pushConstantRange(
+                vk::ShaderStageFlagBits::eCompute, 0, sizeof(uint32_t));
+
+        const ComputePipeline::Description description{
+            shaderModule, { descriptorSetLayout }, { pushConstantRange }
+        };
+
+        std::unique_ptr<ComputePipeline> pipeline = ComputePipeline::Create(description);
+
+        VulkanContext::shaderManager->DestroyShaderModule(shaderModule);
+
+        return pipeline;
+    }
+}
+
+DepthPyramid::DepthPyramid(vk::ImageView depthImageView)
+{
+    SetupTexture(depthImageView);
+
+    pipeline = Details::CreatePipeline(descriptorSets.front().layout);
+}
+
+DepthPyramid::~DepthPyramid()
+{
+    DestroyTexture();
+}
+
+void DepthPyramid::Build(vk::CommandBuffer commandBuffer) const
+{
+    const vk::ImageSubresourceRange subresourceRange(vk::ImageAspectFlagBits::eColor,
+            0, static_cast<uint32_t>(mipLevelViews.size()), 0, 1);
+
+    const ImageLayoutTransition layoutTransition{
+        vk::ImageLayout::eGeneral,
+        vk::ImageLayout::eGeneral,
+        PipelineBarrier{
+            SyncScope::kComputeShaderRead,
+            SyncScope::kComputeShaderWrite
+        }
+    };
+
+    ImageHelpers::TransitImageLayout(commandBuffer, texture.image, subresourceRange, layoutTransition);
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->Get());
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(mipLevelViews.size()); ++i)
+    {
+        commandBuffer.pushConstants<uint32_t>(pipeline->GetLayout(),
+                vk::ShaderStageFlagBits::eCompute, 0, { i });
+
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                pipeline->GetLayout(), 0, { descriptorSets[i].value }, {});
+
+        const vk::Extent2D mipLevelExtent = ImageHelpers::CalculateMipLevelExtent(extent, i);
+
+        const glm::uvec3 groupCount = ComputeHelpers::CalculateWorkGroupCount(
+                mipLevelExtent, Details::kWorkGroupSize);
+
+        commandBuffer.dispatch(groupCount.x, groupCount.y, groupCount.z);
+
+        const vk::ImageSubresourceRange mipLevelRange(vk::ImageAspectFlagBits::eColor, i, 1, 0, 1);
+
+        const ImageLayoutTransition mipLevelTransition{
+            vk::ImageLayout::eGeneral,
+            vk::ImageLayout::eGeneral,
+            PipelineBarrier{
+                SyncScope::kComputeShaderWrite,
+                SyncScope::kComputeShaderRead
+            }
+        };
+
+        ImageHelpers::TransitImageLayout(commandBuffer, texture.image, mipLevelRange, mipLevelTransition);
+    }
+}
+
+void DepthPyramid::Resize(vk::ImageView depthImageView)
+{
+    DestroyTexture();
+
+    SetupTexture(depthImageView);
+}
+
+void DepthPyramid::ReloadShaders()
+{
+    pipeline = Details::CreatePipeline(descriptorSets.front().layout);
+}
+
+void DepthPyramid::SetupTexture(vk::ImageView depthImageView)
+{
+    extent = Details::GetPyramidExtent(VulkanContext::swapchain->GetExtent());
+
+    const uint32_t mipLevelCount = ImageHelpers::CalculateMipLevelCount(extent);
+
+    const ImageDescription imageDescription{
+        ImageType::e2D, kFormat,
+        VulkanHelpers::GetExtent3D(extent),
+        mipLevelCount, 1, vk::SampleCountFlagBits::e1,
+        vk::ImageTiling::eOptimal,
+        vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    texture.image = VulkanContext::imageManager->CreateImage(imageDescription, ImageCreateFlags::kNone);
+
+    const vk::ImageSubresourceRange subresourceRange(
+            vk::ImageAspectFlagBits::eColor, 0, mipLevelCount, 0, 1);
+
+    texture.view = VulkanContext::imageManager->CreateView(
+            texture.image, vk::ImageViewType::e2D, subresourceRange);
+
+    mipLevelViews.resize(mipLevelCount);
+
+    for (uint32_t i = 0; i < mipLevelCount; ++i)
+    {
+        mipLevelViews[i] = VulkanContext::imageManager->CreateView(texture.image,
+                vk::ImageViewType::e2D, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, i, 1, 0, 1));
+    }
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            const ImageLayoutTransition layoutTransition{
+                vk::ImageLayout::eUndefined,
+                vk::ImageLayout::eGeneral,
+                PipelineBarrier{
+                    SyncScope::kWaitForNone,
+                    SyncScope::kTransferWrite
+                }
+            };
+
+            ImageHelpers::TransitImageLayout(commandBuffer, texture.image, subresourceRange, layoutTransition);
+
+            const vk::ClearColorValue clearValue(std::array<float, 4>{ Details::kClearDepth, 0.0f, 0.0f, 0.0f });
+
+            commandBuffer.clearColorImage(texture.image, vk::ImageLayout::eGeneral, clearValue, { subresourceRange });
+
+            const ImageLayoutTransition clearTransition{
+                vk::ImageLayout::eGeneral,
+                vk::ImageLayout::eGeneral,
+                PipelineBarrier{
+                    SyncScope::kTransferWrite,
+                    SyncScope::kComputeShaderRead
+                }
+            };
+
+            ImageHelpers::TransitImageLayout(commandBuffer, texture.image, subresourceRange, clearTransition);
+        });
+
+    const DescriptorDescription sampledImageDescriptorDescription{
+        1, vk::DescriptorType::eCombinedImageSampler,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    const DescriptorDescription storageImageDescriptorDescription{
+        1, vk::DescriptorType::eStorageImage,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    const DescriptorSetDescription descriptorSetDescription{
+        sampledImageDescriptorDescription,
+        storageImageDescriptorDescription,
+        storageImageDescriptorDescription
+    };
+
+    descriptorSets.resize(mipLevelCount);
+
+    for (uint32_t i = 0; i < mipLevelCount; ++i)
+    {
+        const DescriptorSetData descriptorSetData{
+            DescriptorHelpers::GetData(Renderer::texelSampler, depthImageView),
+            DescriptorHelpers::GetData(mipLevelViews[i > 0 ? i - 1 : 0]),
+            DescriptorHelpers::GetData(mipLevelViews[i])
+        };
+
+        descriptorSets[i] = DescriptorHelpers::CreateDescriptorSet(descriptorSetDescription, descriptorSetData);
+    }
+}
+
+void DepthPyramid::DestroyTexture()
+{
+    for (const auto& descriptorSet : descriptorSets)
+    {
+        DescriptorHelpers::DestroyDescriptorSet(descriptorSet);
+    }
+
+    descriptorSets.clear();
+    mipLevelViews.clear();
+
+    VulkanContext::imageManager->DestroyImage(texture.image);
+}
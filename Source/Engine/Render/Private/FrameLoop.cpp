@@ -15,6 +15,8 @@ FrameLoop::FrameLoop()
         frame.sync.fence = VulkanHelpers::CreateFence(VulkanContext::device->Get(), vk::FenceCreateFlagBits::eSignaled);
         frame.sync.waitStages.emplace_back(vk::PipelineStageFlagBits::eRayTracingShaderKHR);
     }
+
+    imageFences.resize(frames.size());
 }
 
 FrameLoop::~FrameLoop()
@@ -43,6 +45,16 @@ void FrameLoop::Draw(RenderCommands renderCommands)
 
     VulkanHelpers::WaitForFences(device, { renderingFence });
 
+    // Images can be acquired out of order, per-image resources are reused only after the frame that last used them
+    const vk::Fence imageFence = imageFences[imageIndex];
+
+    if (imageFence && imageFence != renderingFence)
+    {
+        VulkanHelpers::WaitForFences(device, { imageFence });
+    }
+
+    imageFences[imageIndex] = renderingFence;
+
     const vk::Result resetResult = device.resetFences(1, &renderingFence);
     Assert(resetResult == vk::Result::eSuccess);
 
@@ -3,6 +3,7 @@
 #include "Engine/Render/Vulkan/VulkanConfig.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Scene/DirectLighting.hpp"
+#include "Engine/Scene/EnvironmentSampling.hpp"
 #include "Engine/Scene/ImageBasedLighting.hpp"
 
 namespace Details
@@ -30,6 +31,7 @@ namespace Details
 
 std::unique_ptr<DirectLighting> Renderer::directLighting;
 std::unique_ptr<ImageBasedLighting> Renderer::imageBasedLighting;
+std::unique_ptr<EnvironmentSampling> Renderer::environmentSampling;
 
 vk::Sampler Renderer::defaultSampler;
 vk::Sampler Renderer::texelSampler;
@@ -42,6 +44,7 @@ void Renderer::Create()
 {
     directLighting = std::make_unique<DirectLighting>();
     imageBasedLighting = std::make_unique<ImageBasedLighting>();
+    environmentSampling = std::make_unique<EnvironmentSampling>();
 
     TextureManager& textureManager = *VulkanContext::textureManager;
 
@@ -64,4 +67,5 @@ void Renderer::Destroy()
 
     directLighting.reset();
     imageBasedLighting.reset();
+    environmentSampling.reset();
 }
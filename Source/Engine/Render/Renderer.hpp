@@ -3,6 +3,7 @@
 #include "Vulkan/Resources/TextureHelpers.hpp"
 
 class DirectLighting;
+class EnvironmentSampling;
 class ImageBasedLighting;
 
 class Renderer
@@ -13,6 +14,7 @@ public:
 
     static std::unique_ptr<DirectLighting> directLighting;
     static std::unique_ptr<ImageBasedLighting> imageBasedLighting;
+    static std::unique_ptr<EnvironmentSampling> environmentSampling;
 
     static vk::Sampler defaultSampler;
     static vk::Sampler texelSampler;
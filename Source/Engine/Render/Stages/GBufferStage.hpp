@@ -2,9 +2,12 @@
 
 #include "Engine/Render/Stages/StageHelpers.hpp"
 #include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/FrustumCulling.hpp"
 
 class RenderPass;
 class GraphicsPipeline;
+class ComputePipeline;
+class DepthPyramid;
 
 class GBufferStage
 {
@@ -19,36 +22,103 @@ public:
 
     static constexpr vk::Format kDepthFormat = kFormats.back();
 
+    struct GpuCullingStats
+    {
+        uint32_t drawCount = 0;
+        uint32_t visibleDrawCount = 0;
+        uint32_t batchCount = 0;
+        uint32_t visibleBatchCount = 0;
+    };
+
     GBufferStage(Scene* scene_, Camera* camera_,
             const std::vector<vk::ImageView>& imageViews);
 
     ~GBufferStage();
 
-    void Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
+    void Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex);
 
     void Resize(const std::vector<vk::ImageView>& imageViews);
 
     void ReloadShaders();
 
+    const FrustumCulling::Stats& GetCullingStats() const { return frustumCulling->GetStats(); }
+
+    const GpuCullingStats& GetGpuCullingStats() const { return gpuCullingStats; }
+
 private:
     struct MaterialPipeline
     {
         Scene::PipelineState state;
         std::unique_ptr<GraphicsPipeline> pipeline;
-        std::vector<uint32_t> materialIndices;
+    };
+
+    struct InstanceData
+    {
+        vk::Buffer buffer;
+        std::vector<vk::Buffer> visibleObjectsBuffers;
+        MultiDescriptorSet descriptorSet;
+    };
+
+    struct CullingData
+    {
+        vk::Buffer drawsBuffer;
+        std::vector<vk::Buffer> indirectBuffers;
+        std::vector<vk::Buffer> countBuffers;
+        std::vector<vk::Buffer> statsBuffers;
+        MultiDescriptorSet descriptorSet;
+        uint32_t drawCount = 0;
+    };
+
+    struct OcclusionData
+    {
+        std::vector<vk::Buffer> buffers;
+        vk::Buffer retestBuffer;
+        MultiDescriptorSet descriptorSet;
     };
 
     Scene* scene = nullptr;
     Camera* camera = nullptr;
 
     std::unique_ptr<RenderPass> renderPass;
+    std::unique_ptr<RenderPass> lateRenderPass;
     vk::Framebuffer framebuffer;
 
     CameraData cameraData;
 
+    InstanceData instanceData;
+
+    std::unique_ptr<FrustumCulling> frustumCulling;
+
     std::vector<MaterialPipeline> pipelines;
+    std::vector<uint32_t> materialPipelineIndices;
+
+    CullingData cullingData;
+    std::unique_ptr<ComputePipeline> cullingPipeline;
+    GpuCullingStats gpuCullingStats;
+
+    OcclusionData occlusionData;
+    std::unique_ptr<DepthPyramid> depthPyramid;
+    glm::mat4 lastViewProj = Matrix4::kIdentity;
 
     void SetupCameraData();
 
+    void SetupInstanceData();
+
     void SetupPipelines();
+
+    void SetupCullingData();
+
+    void SetupCullingPipeline();
+
+    void SetupOcclusionData(vk::ImageView depthImageView);
+
+    void SetupOcclusionDescriptorSet();
+
+    void CullMeshlets(vk::CommandBuffer commandBuffer, uint32_t imageIndex, uint32_t phase) const;
+
+    void DrawBatches(vk::CommandBuffer commandBuffer, uint32_t imageIndex, uint32_t phase) const;
+
+    void CopyGpuCullingStats(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
+
+    void ReadGpuCullingStats(uint32_t imageIndex);
 };
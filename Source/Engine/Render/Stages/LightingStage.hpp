@@ -16,7 +16,7 @@ public:
 
     ~LightingStage();
 
-    void Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
+    void Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex);
 
     void Resize(const std::vector<vk::ImageView>& gBufferImageViews);
 
@@ -29,6 +29,16 @@ private:
         DescriptorSet descriptorSet;
     };
 
+    struct ClusteringData
+    {
+        std::vector<vk::Buffer> uniformBuffers;
+        vk::Buffer lightCountsBuffer;
+        vk::Buffer lightIndicesBuffer;
+        std::vector<vk::Buffer> overflowBuffers;
+        MultiDescriptorSet descriptorSet;
+        uint32_t reportedLightCount = 0;
+    };
+
     Scene* scene = nullptr;
     Camera* camera = nullptr;
     Environment* environment = nullptr;
@@ -41,9 +51,18 @@ private:
 
     std::unique_ptr<ComputePipeline> pipeline;
 
+    std::optional<ClusteringData> clusteringData;
+    std::unique_ptr<ComputePipeline> clusteringPipeline;
+
     void SetupCameraData();
 
     void SetupLightingData();
 
+    void SetupClusteringData();
+
     void SetupPipeline();
+
+    void BuildLightClusters(vk::CommandBuffer commandBuffer, uint32_t imageIndex);
+
+    void ReportClusterOverflow(uint32_t imageIndex);
 };
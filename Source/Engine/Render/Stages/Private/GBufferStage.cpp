@@ -1,15 +1,61 @@
 #include "Engine/Render/Stages/GBufferStage.hpp"
 
+#include "Engine/Render/DepthPyramid.hpp"
+#include "Engine/Render/Renderer.hpp"
+#include "Engine/Render/Vulkan/ComputePipeline.hpp"
 #include "Engine/Render/Vulkan/GraphicsPipeline.hpp"
 #include "Engine/Render/Vulkan/RenderPass.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Render/Vulkan/VulkanHelpers.hpp"
+#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
 #include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
+#include "Engine/Camera.hpp"
+#include "Engine/Config.hpp"
+
+#include "Shaders/Hybrid/Hybrid.h"
 
 namespace Details
 {
-    static std::unique_ptr<RenderPass> CreateRenderPass()
+    static constexpr uint32_t kCullingWorkGroupSize = 64;
+
+    static constexpr bool kGpuCulling = Config::kMeshletCulling || Config::kGpuDrivenRendering;
+
+    // Off in the default configuration, GPU-driven rendering tests the frustum in MeshletCulling.comp instead
+    static constexpr bool kCpuFrustumCulling = Config::kFrustumCulling && !Config::kGpuDrivenRendering;
+
+    static constexpr bool kInstanceIndirection = kCpuFrustumCulling && !Config::kMeshletCulling;
+
+    static constexpr bool kOcclusionCulling = Config::kOcclusionCulling && Config::kGpuDrivenRendering;
+
+    static constexpr uint32_t kCullingPhaseCount = kOcclusionCulling ? 2 : 1;
+
+    struct VertexPushConstants
+    {
+        glm::vec4 positionOffset;
+        glm::vec4 positionScale;
+    };
+
+    struct CullingPushConstants
     {
+        std::array<glm::vec4, 6> frustumPlanes;
+        glm::vec3 cameraPosition;
+        uint32_t drawCount;
+        uint32_t phase;
+        float lodScale;
+    };
+
+    struct OcclusionUniforms
+    {
+        glm::mat4 viewProj;
+        glm::mat4 lastViewProj;
+        glm::vec4 depthExtent;
+    };
+
+    static std::unique_ptr<RenderPass> CreateRenderPass(vk::AttachmentLoadOp loadOp)
+    {
+        const vk::ImageLayout depthInitialLayout = loadOp == vk::AttachmentLoadOp::eLoad
+                ? vk::ImageLayout::eShaderReadOnlyOptimal : vk::ImageLayout::eDepthStencilAttachmentOptimal;
+
         std::vector<RenderPass::AttachmentDescription> attachments(GBufferStage::kFormats.size());
 
         for (size_t i = 0; i < attachments.size(); ++i)
@@ -19,9 +65,9 @@ namespace Details
                 attachments[i] = RenderPass::AttachmentDescription{
                     RenderPass::AttachmentUsage::eDepth,
                     GBufferStage::kFormats[i],
-                    vk::AttachmentLoadOp::eClear,
+                    loadOp,
                     vk::AttachmentStoreOp::eStore,
-                    vk::ImageLayout::eDepthStencilAttachmentOptimal,
+                    depthInitialLayout,
                     vk::ImageLayout::eDepthStencilAttachmentOptimal,
                     vk::ImageLayout::eShaderReadOnlyOptimal
                 };
@@ -31,7 +77,7 @@ namespace Details
                 attachments[i] = RenderPass::AttachmentDescription{
                     RenderPass::AttachmentUsage::eColor,
                     GBufferStage::kFormats[i],
-                    vk::AttachmentLoadOp::eClear,
+                    loadOp,
                     vk::AttachmentStoreOp::eStore,
                     vk::ImageLayout::eGeneral,
                     vk::ImageLayout::eColorAttachmentOptimal,
@@ -53,8 +99,21 @@ namespace Details
             }
         };
 
+        std::vector<PipelineBarrier> previousDependencies;
+
+        if (loadOp == vk::AttachmentLoadOp::eLoad)
+        {
+            previousDependencies = {
+                PipelineBarrier{
+                    SyncScope::kColorAttachmentWrite | SyncScope::kComputeShaderRead,
+                    SyncScope::kColorAttachmentWrite | SyncScope::kDepthStencilAttachmentRead
+                            | SyncScope::kDepthStencilAttachmentWrite
+                }
+            };
+        }
+
         std::unique_ptr<RenderPass> renderPass = RenderPass::Create(description,
-                RenderPass::Dependencies{ {}, followingDependencies });
+                RenderPass::Dependencies{ previousDependencies, followingDependencies });
 
         return renderPass;
     }
@@ -73,6 +132,10 @@ namespace Details
             const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts,
             const Scene::PipelineState& pipelineState)
     {
+        const std::map<std::string, uint32_t> vertexDefines{
+            { "INSTANCE_INDIRECTION", static_cast<uint32_t>(kInstanceIndirection) }
+        };
+
         const std::map<std::string, uint32_t> defines{
             { "ALPHA_TEST", static_cast<uint32_t>(pipelineState.alphaTest) },
             { "DOUBLE_SIDED", static_cast<uint32_t>(pipelineState.doubleSided) }
@@ -84,7 +147,7 @@ namespace Details
         const std::vector<ShaderModule> shaderModules{
             VulkanContext::shaderManager->CreateShaderModule(
                     vk::ShaderStageFlagBits::eVertex,
-                    Filepath("~/Shaders/Hybrid/GBuffer.vert"), {}),
+                    Filepath("~/Shaders/Hybrid/GBuffer.vert"), vertexDefines),
             VulkanContext::shaderManager->CreateShaderModule(
                     vk::ShaderStageFlagBits::eFragment,
                     Filepath("~/Shaders/Hybrid/GBuffer.frag"), defines)
@@ -98,8 +161,8 @@ namespace Details
         const std::vector<BlendMode> blendModes = Repeat(BlendMode::eDisabled, GBufferStage::kFormats.size() - 1);
 
         const std::vector<vk::PushConstantRange> pushConstantRanges{
-            vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0, sizeof(glm::mat4)),
-            vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, sizeof(glm::mat4), sizeof(glm::vec3))
+            vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0, sizeof(VertexPushConstants)),
+            vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, sizeof(VertexPushConstants), sizeof(glm::vec3))
         };
 
         const GraphicsPipeline::Description description{
@@ -126,9 +189,100 @@ namespace Details
         return pipeline;
     }
 
-    static std::vector<vk::ClearValue> GetClearValues()
+    static std::unique_ptr<ComputePipeline> CreateCullingPipeline(
+            const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts)
     {
-        std::vector<vk::ClearValue> clearValues(GBufferStage::kFormats.size());
+        const std::map<std::string, uint32_t> defines{
+            { "COMPACT_DRAWS", static_cast<uint32_t>(Config::kGpuDrivenRendering) },
+            { "OCCLUSION_CULLING", static_cast<uint32_t>(kOcclusionCulling) },
+            { "REVERSE_DEPTH", static_cast<uint32_t>(Config::kReverseDepth) }
+        };
+
+        const std::tuple specializationValues = std::make_tuple(kCullingWorkGroupSize);
+
+        const ShaderModule shaderModule = VulkanContext::shaderManager->CreateShaderModule(
+                vk::ShaderStageFlagBits::eCompute, Filepath("~/Shaders/Hybrid/MeshletCulling.comp"),
+                defines, specializationValues);
+
+        const vk::PushConstantRange pushConstantRange(
+                vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullingPushConstants));
+
+        const ComputePipeline::Description description{
+            shaderModule, descriptorSetLayouts, { pushConstantRange }
+        };
+
+        std::unique_ptr<ComputePipeline> pipeline = ComputePipeline::Create(description);
+
+        VulkanContext::shaderManager->DestroyShaderModule(shaderModule);
+
+        return pipeline;
+    }
+
+    static uint32_t GetBatchDrawCount(const Scene::Mesh& mesh, uint32_t objectCount)
+    {
+        if constexpr (Config::kMeshletCulling)
+        {
+            return mesh.meshletCount * objectCount;
+        }
+        else
+        {
+            return mesh.lodCount * objectCount;
+        }
+    }
+
+    // Distance at which one unit of object space error projects to the LOD pixel error threshold
+    static float GetLodScale(const Camera& camera)
+    {
+        const vk::Extent2D& extent = VulkanContext::swapchain->GetExtent();
+
+        const float projectionScale = static_cast<float>(extent.width)
+                / (2.0f * std::tan(camera.GetDescription().xFov * 0.5f));
+
+        return projectionScale / Config::kLodPixelError;
+    }
+
+    // Same metric as IsLodSelected in MeshletCulling.comp, the batch draws the finest LOD any of its objects needs
+    static const MeshLod& SelectBatchLod(const Scene::Hierarchy& hierarchy, const Scene::RenderQueue& renderQueue,
+            const Scene::RenderBatch& batch, const glm::vec3& cameraPosition, float lodScale)
+    {
+        const Scene::Mesh& mesh = hierarchy.meshes[batch.meshIndex];
+
+        const glm::vec3 extent = mesh.positionScale * 0.5f;
+        const glm::vec3 lodCenter = mesh.positionOffset + extent;
+        const float lodRadius = glm::length(extent);
+
+        uint32_t lodIndex = mesh.lodCount - 1;
+
+        for (uint32_t i = batch.firstObject; i < batch.firstObject + batch.objectCount && lodIndex > 0; ++i)
+        {
+            const glm::mat4& transform = hierarchy.renderObjects[renderQueue.objectIndices[i]].transform;
+
+            const float scale = std::max(glm::length(glm::vec3(transform[0])),
+                    std::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+
+            const glm::vec3 center = glm::vec3(transform * glm::vec4(lodCenter, 1.0f));
+            const float distance = std::max(glm::length(center - cameraPosition) - lodRadius * scale, 0.0f);
+
+            while (lodIndex > 0 && hierarchy.lods[mesh.lodOffset + lodIndex].error * scale * lodScale > distance)
+            {
+                --lodIndex;
+            }
+        }
+
+        return hierarchy.lods[mesh.lodOffset + lodIndex];
+    }
+
+    static DescriptorData GetStorageBufferData(vk::Buffer buffer)
+    {
+        return DescriptorData{
+            vk::DescriptorType::eStorageBuffer,
+            BufferInfo{ vk::DescriptorBufferInfo(buffer, 0, VK_WHOLE_SIZE) }
+        };
+    }
+
+    static std::array<vk::ClearValue, GBufferStage::kFormats.size()> GetClearValues()
+    {
+        std::array<vk::ClearValue, GBufferStage::kFormats.size()> clearValues;
 
         for (size_t i = 0; i < clearValues.size(); ++i)
         {
@@ -151,15 +305,71 @@ GBufferStage::GBufferStage(Scene* scene_, Camera* camera_,
     : scene(scene_)
     , camera(camera_)
 {
-    renderPass = Details::CreateRenderPass();
+    renderPass = Details::CreateRenderPass(vk::AttachmentLoadOp::eClear);
     framebuffer = Details::CreateFramebuffer(*renderPass, imageViews);
 
+    if constexpr (Details::kOcclusionCulling)
+    {
+        lateRenderPass = Details::CreateRenderPass(vk::AttachmentLoadOp::eLoad);
+    }
+
     SetupCameraData();
+    SetupInstanceData();
     SetupPipelines();
+
+    if constexpr (Details::kGpuCulling)
+    {
+        SetupCullingData();
+
+        if constexpr (Details::kOcclusionCulling)
+        {
+            SetupOcclusionData(imageViews.back());
+        }
+
+        SetupCullingPipeline();
+    }
 }
 
 GBufferStage::~GBufferStage()
 {
+    if constexpr (Details::kOcclusionCulling)
+    {
+        DescriptorHelpers::DestroyMultiDescriptorSet(occlusionData.descriptorSet);
+        for (const auto& buffer : occlusionData.buffers)
+        {
+            VulkanContext::bufferManager->DestroyBuffer(buffer);
+        }
+
+        VulkanContext::bufferManager->DestroyBuffer(occlusionData.retestBuffer);
+    }
+
+    if constexpr (Details::kGpuCulling)
+    {
+        DescriptorHelpers::DestroyMultiDescriptorSet(cullingData.descriptorSet);
+        for (const auto& buffer : cullingData.indirectBuffers)
+        {
+            VulkanContext::bufferManager->DestroyBuffer(buffer);
+        }
+        for (const auto& buffer : cullingData.countBuffers)
+        {
+            VulkanContext::bufferManager->DestroyBuffer(buffer);
+        }
+        for (const auto& buffer : cullingData.statsBuffers)
+        {
+            VulkanContext::bufferManager->DestroyBuffer(buffer);
+        }
+
+        VulkanContext::bufferManager->DestroyBuffer(cullingData.drawsBuffer);
+    }
+
+    DescriptorHelpers::DestroyMultiDescriptorSet(instanceData.descriptorSet);
+    for (const auto& buffer : instanceData.visibleObjectsBuffers)
+    {
+        VulkanContext::bufferManager->DestroyBuffer(buffer);
+    }
+
+    VulkanContext::bufferManager->DestroyBuffer(instanceData.buffer);
+
     DescriptorHelpers::DestroyMultiDescriptorSet(cameraData.descriptorSet);
     for (const auto& buffer : cameraData.buffers)
     {
@@ -169,57 +379,197 @@ GBufferStage::~GBufferStage()
     VulkanContext::device->Get().destroyFramebuffer(framebuffer);
 }
 
-void GBufferStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+void GBufferStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
 {
+    if constexpr (Config::kGpuDrivenRendering)
+    {
+        ReadGpuCullingStats(imageIndex);
+    }
+
     const glm::mat4 viewProj = camera->GetProjectionMatrix() * camera->GetViewMatrix();
 
     BufferHelpers::UpdateBuffer(commandBuffer, cameraData.buffers[imageIndex],
             ByteView(viewProj), SyncScope::kWaitForNone, SyncScope::kVertexUniformRead);
 
+    if constexpr (Details::kCpuFrustumCulling)
+    {
+        frustumCulling->Cull(camera->GetFrustumPlanes());
+
+        if constexpr (Details::kInstanceIndirection)
+        {
+            const std::vector<uint32_t>& visibleObjects = frustumCulling->GetVisibleObjects();
+
+            if (!visibleObjects.empty())
+            {
+                VulkanContext::bufferManager->UpdateBuffer(commandBuffer,
+                        instanceData.visibleObjectsBuffers[imageIndex], ByteView(visibleObjects));
+            }
+        }
+    }
+
+    if constexpr (Details::kOcclusionCulling)
+    {
+        const vk::Extent2D& extent = VulkanContext::swapchain->GetExtent();
+
+        const Details::OcclusionUniforms occlusionUniforms{
+            viewProj, lastViewProj,
+            glm::vec4(static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 0.0f)
+        };
+
+        BufferHelpers::UpdateBuffer(commandBuffer, occlusionData.buffers[imageIndex],
+                ByteView(occlusionUniforms), SyncScope::kWaitForNone, SyncScope::kComputeUniformRead);
+
+        lastViewProj = viewProj;
+    }
+
+    if constexpr (Details::kGpuCulling)
+    {
+        CullMeshlets(commandBuffer, imageIndex, 0);
+    }
+
+    DrawBatches(commandBuffer, imageIndex, 0);
+
+    if constexpr (Details::kOcclusionCulling)
+    {
+        depthPyramid->Build(commandBuffer);
+
+        CullMeshlets(commandBuffer, imageIndex, 1);
+
+        DrawBatches(commandBuffer, imageIndex, 1);
+
+        depthPyramid->Build(commandBuffer);
+    }
+
+    if constexpr (Config::kGpuDrivenRendering)
+    {
+        CopyGpuCullingStats(commandBuffer, imageIndex);
+    }
+}
+
+void GBufferStage::DrawBatches(vk::CommandBuffer commandBuffer, uint32_t imageIndex, uint32_t phase) const
+{
     const glm::vec3& cameraPosition = camera->GetDescription().position;
     const Scene::Hierarchy& sceneHierarchy = scene->GetHierarchy();
     const Scene::DescriptorSets& sceneDescriptorSets = scene->GetDescriptorSets();
 
     const vk::Rect2D renderArea = StageHelpers::GetSwapchainRenderArea();
     const vk::Viewport viewport = StageHelpers::GetSwapchainViewport();
-    const std::vector<vk::ClearValue> clearValues = Details::GetClearValues();
+    const std::array<vk::ClearValue, kFormats.size()> clearValues = Details::GetClearValues();
+
+    const vk::RenderPass currentRenderPass = phase == 0 ? renderPass->Get() : lateRenderPass->Get();
 
     const vk::RenderPassBeginInfo beginInfo(
-            renderPass->Get(), framebuffer,
+            currentRenderPass, framebuffer,
             renderArea, clearValues);
 
     commandBuffer.beginRenderPass(beginInfo, vk::SubpassContents::eInline);
 
-    for (const auto& [state, pipeline, materialIndices] : pipelines)
+    const Scene::RenderQueue& renderQueue = scene->GetRenderQueue();
+
+    uint32_t pipelineIndex = std::numeric_limits<uint32_t>::max();
+    uint32_t materialIndex = std::numeric_limits<uint32_t>::max();
+
+    const float lodScale = Details::GetLodScale(*camera);
+
+    uint32_t drawOffset = 0;
+
+    for (size_t i = 0; i < renderQueue.batches.size(); ++i)
     {
-        commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->Get());
+        const auto& [batchMaterialIndex, meshIndex, firstObject, objectCount] = renderQueue.batches[i];
+
+        const Scene::Mesh& mesh = sceneHierarchy.meshes[meshIndex];
 
-        commandBuffer.setViewport(0, { viewport });
-        commandBuffer.setScissor(0, { renderArea });
+        uint32_t firstInstance = firstObject;
+        uint32_t instanceCount = objectCount;
 
-        commandBuffer.pushConstants<glm::vec3>(pipeline->GetLayout(),
-                vk::ShaderStageFlagBits::eFragment, sizeof(glm::mat4), { cameraPosition });
+        if constexpr (Details::kCpuFrustumCulling)
+        {
+            const FrustumCulling::VisibleRange& visibleRange = frustumCulling->GetVisibleRanges()[i];
 
-        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                pipeline->GetLayout(), 0, { cameraData.descriptorSet.values[imageIndex] }, {});
+            if (visibleRange.objectCount == 0)
+            {
+                drawOffset += Config::kMeshletCulling ? mesh.meshletCount * objectCount : 0;
+                continue;
+            }
 
-        for (uint32_t i : materialIndices)
+            if constexpr (Details::kInstanceIndirection)
+            {
+                firstInstance = visibleRange.firstObject;
+                instanceCount = visibleRange.objectCount;
+            }
+        }
+
+        const GraphicsPipeline& pipeline = *pipelines[materialPipelineIndices[batchMaterialIndex]].pipeline;
+
+        if (materialPipelineIndices[batchMaterialIndex] != pipelineIndex)
         {
+            pipelineIndex = materialPipelineIndices[batchMaterialIndex];
+            materialIndex = std::numeric_limits<uint32_t>::max();
+
+            commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.Get());
+
+            commandBuffer.setViewport(0, { viewport });
+            commandBuffer.setScissor(0, { renderArea });
+
+            commandBuffer.pushConstants<glm::vec3>(pipeline.GetLayout(),
+                    vk::ShaderStageFlagBits::eFragment, sizeof(Details::VertexPushConstants), { cameraPosition });
+
             commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                    pipeline->GetLayout(), 1, { sceneDescriptorSets.materials.values[i] }, {});
+                    pipeline.GetLayout(), 0, { cameraData.descriptorSet.values[imageIndex] }, {});
 
-            for (const auto& renderObject : scene->GetRenderObjects(i))
-            {
-                const Scene::Mesh& mesh = sceneHierarchy.meshes[renderObject.meshIndex];
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+                    pipeline.GetLayout(), 2, { instanceData.descriptorSet.values[imageIndex] }, {});
+        }
 
-                commandBuffer.bindIndexBuffer(mesh.indexBuffer, 0, mesh.indexType);
-                commandBuffer.bindVertexBuffers(0, { mesh.vertexBuffer }, { 0 });
+        if (batchMaterialIndex != materialIndex)
+        {
+            materialIndex = batchMaterialIndex;
 
-                commandBuffer.pushConstants<glm::mat4>(pipeline->GetLayout(),
-                        vk::ShaderStageFlagBits::eVertex, 0, { renderObject.transform });
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+                    pipeline.GetLayout(), 1, { sceneDescriptorSets.materials.values[materialIndex] }, {});
+        }
 
-                commandBuffer.drawIndexed(mesh.indexCount, 1, 0, 0, 0);
-            }
+        commandBuffer.bindIndexBuffer(mesh.indexBuffer, 0, mesh.indexType);
+        commandBuffer.bindVertexBuffers(0, { mesh.vertexBuffer }, { 0 });
+
+        const Details::VertexPushConstants vertexPushConstants{
+            glm::vec4(mesh.positionOffset, 0.0f),
+            glm::vec4(mesh.positionScale, 0.0f)
+        };
+
+        commandBuffer.pushConstants<Details::VertexPushConstants>(pipeline.GetLayout(),
+                vk::ShaderStageFlagBits::eVertex, 0, { vertexPushConstants });
+
+        if constexpr (Config::kGpuDrivenRendering)
+        {
+            const uint32_t maxDrawCount = Details::GetBatchDrawCount(mesh, objectCount);
+
+            const uint32_t phaseDrawOffset = cullingData.drawCount * phase + drawOffset;
+            const uint32_t countIndex = static_cast<uint32_t>(i) * Details::kCullingPhaseCount + phase;
+
+            commandBuffer.drawIndexedIndirectCountKHR(cullingData.indirectBuffers[imageIndex],
+                    sizeof(vk::DrawIndexedIndirectCommand) * phaseDrawOffset,
+                    cullingData.countBuffers[imageIndex], sizeof(uint32_t) * countIndex,
+                    maxDrawCount, sizeof(vk::DrawIndexedIndirectCommand));
+
+            drawOffset += maxDrawCount;
+        }
+        else if constexpr (Config::kMeshletCulling)
+        {
+            const uint32_t drawCount = mesh.meshletCount * objectCount;
+
+            commandBuffer.drawIndexedIndirect(cullingData.indirectBuffers[imageIndex],
+                    sizeof(vk::DrawIndexedIndirectCommand) * drawOffset, drawCount,
+                    sizeof(vk::DrawIndexedIndirectCommand));
+
+            drawOffset += drawCount;
+        }
+        else
+        {
+            const MeshLod& lod = Details::SelectBatchLod(sceneHierarchy, renderQueue,
+                    renderQueue.batches[i], cameraPosition, lodScale);
+
+            commandBuffer.drawIndexed(lod.indexCount, instanceCount, lod.firstIndex, 0, firstInstance);
         }
     }
 
@@ -231,11 +581,31 @@ void GBufferStage::Resize(const std::vector<vk::ImageView>& imageViews)
     VulkanContext::device->Get().destroyFramebuffer(framebuffer);
 
     framebuffer = Details::CreateFramebuffer(*renderPass, imageViews);
+
+    if constexpr (Details::kOcclusionCulling)
+    {
+        depthPyramid->Resize(imageViews.back());
+
+        DescriptorHelpers::DestroyMultiDescriptorSet(occlusionData.descriptorSet);
+
+        SetupOcclusionDescriptorSet();
+        SetupCullingPipeline();
+    }
 }
 
 void GBufferStage::ReloadShaders()
 {
     SetupPipelines();
+
+    if constexpr (Details::kGpuCulling)
+    {
+        SetupCullingPipeline();
+    }
+
+    if constexpr (Details::kOcclusionCulling)
+    {
+        depthPyramid->ReloadShaders();
+    }
 }
 
 void GBufferStage::SetupCameraData()
@@ -249,16 +619,75 @@ void GBufferStage::SetupCameraData()
     cameraData = StageHelpers::CreateCameraData(bufferCount, bufferSize, shaderStages);
 }
 
+void GBufferStage::SetupInstanceData()
+{
+    const Scene::Hierarchy& sceneHierarchy = scene->GetHierarchy();
+    const Scene::RenderQueue& renderQueue = scene->GetRenderQueue();
+
+    std::vector<Instance> instances;
+    instances.reserve(renderQueue.objectIndices.size());
+
+    for (uint32_t i : renderQueue.objectIndices)
+    {
+        const glm::mat4& transform = sceneHierarchy.renderObjects[i].transform;
+
+        instances.push_back(Instance{ transform, glm::inverse(transform) });
+    }
+
+    instanceData.buffer = BufferHelpers::CreateBufferWithData(
+            vk::BufferUsageFlagBits::eStorageBuffer, ByteView(instances));
+
+    const size_t bufferCount = VulkanContext::swapchain->GetImages().size();
+
+    std::vector<DescriptorSetData> multiDescriptorSetData(bufferCount);
+
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+        multiDescriptorSetData[i] = { Details::GetStorageBufferData(instanceData.buffer) };
+
+        if constexpr (Details::kInstanceIndirection)
+        {
+            const BufferDescription bufferDescription{
+                std::max(sizeof(uint32_t) * instances.size(), sizeof(uint32_t)),
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+            };
+
+            instanceData.visibleObjectsBuffers.push_back(VulkanContext::bufferManager->CreateBuffer(
+                    bufferDescription, BufferCreateFlags::kNone));
+
+            multiDescriptorSetData[i].push_back(
+                    Details::GetStorageBufferData(instanceData.visibleObjectsBuffers[i]));
+        }
+    }
+
+    const DescriptorDescription descriptorDescription{
+        1, vk::DescriptorType::eStorageBuffer,
+        vk::ShaderStageFlagBits::eVertex,
+        vk::DescriptorBindingFlags()
+    };
+
+    instanceData.descriptorSet = DescriptorHelpers::CreateMultiDescriptorSet(
+            Repeat(descriptorDescription, multiDescriptorSetData.front().size()), multiDescriptorSetData);
+
+    if constexpr (Details::kCpuFrustumCulling)
+    {
+        frustumCulling = std::make_unique<FrustumCulling>(*scene);
+    }
+}
+
 void GBufferStage::SetupPipelines()
 {
     pipelines.clear();
+    materialPipelineIndices.clear();
 
     const Scene::Hierarchy& sceneHierarchy = scene->GetHierarchy();
     const Scene::DescriptorSets& sceneDescriptorSets = scene->GetDescriptorSets();
 
     const std::vector<vk::DescriptorSetLayout> scenePipelineLayouts{
         cameraData.descriptorSet.layout,
-        sceneDescriptorSets.materials.layout
+        sceneDescriptorSets.materials.layout,
+        instanceData.descriptorSet.layout
     };
 
     for (uint32_t i = 0; i < static_cast<uint32_t>(sceneHierarchy.materials.size()); ++i)
@@ -272,20 +701,381 @@ void GBufferStage::SetupPipelines()
 
         const auto it = std::find_if(pipelines.begin(), pipelines.end(), pred);
 
-        if (it != pipelines.end())
-        {
-            it->materialIndices.push_back(i);
-        }
-        else
+        materialPipelineIndices.push_back(static_cast<uint32_t>(std::distance(pipelines.begin(), it)));
+
+        if (it == pipelines.end())
         {
             std::unique_ptr<GraphicsPipeline> pipeline = Details::CreatePipeline(
                     *renderPass, scenePipelineLayouts, material.pipelineState);
 
             pipelines.push_back(MaterialPipeline{
                 material.pipelineState,
-                std::move(pipeline),
-                { i }
+                std::move(pipeline)
             });
         }
     }
 }
+
+void GBufferStage::SetupCullingData()
+{
+    const Scene::Hierarchy& sceneHierarchy = scene->GetHierarchy();
+
+    const std::vector<Scene::RenderBatch>& batches = scene->GetRenderQueue().batches;
+
+    std::vector<MeshletDraw> draws;
+
+    for (uint32_t batchIndex = 0; batchIndex < static_cast<uint32_t>(batches.size()); ++batchIndex)
+    {
+        const auto& [materialIndex, meshIndex, firstObject, objectCount] = batches[batchIndex];
+
+        const Scene::Mesh& mesh = sceneHierarchy.meshes[meshIndex];
+
+        const bool backfaceCulling = !sceneHierarchy.materials[materialIndex].pipelineState.doubleSided;
+
+        const uint32_t batchDrawOffset = static_cast<uint32_t>(draws.size());
+
+        // Mesh bounds come from the quantization range
+        const glm::vec3 extent = mesh.positionScale * 0.5f;
+        const glm::vec4 meshSphere(mesh.positionOffset + extent, glm::length(extent));
+
+        for (uint32_t i = firstObject; i < firstObject + objectCount; ++i)
+        {
+            for (uint32_t j = mesh.lodOffset; j < mesh.lodOffset + mesh.lodCount; ++j)
+            {
+                const MeshLod& lod = sceneHierarchy.lods[j];
+
+                const float nextLodError = j + 1 < mesh.lodOffset + mesh.lodCount
+                        ? sceneHierarchy.lods[j + 1].error : std::numeric_limits<float>::max();
+
+                if constexpr (Config::kMeshletCulling)
+                {
+                    const uint32_t firstMeshlet = mesh.meshletOffset + lod.firstMeshlet;
+
+                    for (uint32_t k = firstMeshlet; k < firstMeshlet + lod.meshletCount; ++k)
+                    {
+                        const Meshlet& meshlet = sceneHierarchy.meshlets[k];
+
+                        draws.push_back(MeshletDraw{
+                            glm::vec4(meshlet.center, meshlet.radius),
+                            glm::vec4(meshlet.coneAxis, meshlet.coneCutoff),
+                            meshSphere,
+                            meshlet.firstIndex,
+                            meshlet.indexCount,
+                            i,
+                            static_cast<uint32_t>(backfaceCulling),
+                            batchIndex,
+                            batchDrawOffset,
+                            lod.error,
+                            nextLodError
+                        });
+                    }
+                }
+                else
+                {
+                    // Whole LOD is culled as one cluster
+                    draws.push_back(MeshletDraw{
+                        meshSphere,
+                        glm::vec4(Direction::kForward, 1.0f),
+                        meshSphere,
+                        lod.firstIndex,
+                        lod.indexCount,
+                        i,
+                        0,
+                        batchIndex,
+                        batchDrawOffset,
+                        lod.error,
+                        nextLodError
+                    });
+                }
+            }
+        }
+    }
+
+    cullingData.drawCount = static_cast<uint32_t>(draws.size());
+
+    cullingData.drawsBuffer = BufferHelpers::CreateBufferWithData(
+            vk::BufferUsageFlagBits::eStorageBuffer, ByteView(draws));
+
+    const BufferDescription indirectBufferDescription{
+        sizeof(vk::DrawIndexedIndirectCommand) * draws.size() * Details::kCullingPhaseCount,
+        vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    const BufferDescription countBufferDescription{
+        sizeof(uint32_t) * std::max(batches.size(), size_t(1)) * Details::kCullingPhaseCount,
+        vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer
+                | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    const BufferDescription statsBufferDescription{
+        countBufferDescription.size,
+        vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+    };
+
+    const size_t bufferCount = VulkanContext::swapchain->GetImages().size();
+
+    cullingData.indirectBuffers.resize(bufferCount);
+
+    std::vector<DescriptorSetData> multiDescriptorSetData(bufferCount);
+
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+        cullingData.indirectBuffers[i] = VulkanContext::bufferManager->CreateBuffer(
+                indirectBufferDescription, BufferCreateFlags::kNone);
+
+        multiDescriptorSetData[i] = DescriptorSetData{
+            Details::GetStorageBufferData(cullingData.drawsBuffer),
+            Details::GetStorageBufferData(instanceData.buffer),
+            Details::GetStorageBufferData(cullingData.indirectBuffers[i])
+        };
+
+        if constexpr (Config::kGpuDrivenRendering)
+        {
+            cullingData.countBuffers.push_back(VulkanContext::bufferManager->CreateBuffer(
+                    countBufferDescription, BufferCreateFlags::kNone));
+
+            cullingData.statsBuffers.push_back(VulkanContext::bufferManager->CreateBuffer(
+                    statsBufferDescription, BufferCreateFlags::kNone));
+
+            const MemoryManager& memoryManager = *VulkanContext::memoryManager;
+            const MemoryBlock memoryBlock = memoryManager.GetBufferMemoryBlock(cullingData.statsBuffers.back());
+
+            std::memset(memoryManager.MapMemory(memoryBlock).data, 0, statsBufferDescription.size);
+
+            memoryManager.UnmapMemory(memoryBlock);
+
+            multiDescriptorSetData[i].push_back(Details::GetStorageBufferData(cullingData.countBuffers[i]));
+        }
+    }
+
+    const DescriptorDescription descriptorDescription{
+        1, vk::DescriptorType::eStorageBuffer,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    cullingData.descriptorSet = DescriptorHelpers::CreateMultiDescriptorSet(
+            Repeat(descriptorDescription, multiDescriptorSetData.front().size()), multiDescriptorSetData);
+}
+
+void GBufferStage::SetupCullingPipeline()
+{
+    std::vector<vk::DescriptorSetLayout> descriptorSetLayouts{ cullingData.descriptorSet.layout };
+
+    if constexpr (Details::kOcclusionCulling)
+    {
+        descriptorSetLayouts.push_back(occlusionData.descriptorSet.layout);
+    }
+
+    cullingPipeline = Details::CreateCullingPipeline(descriptorSetLayouts);
+}
+
+void GBufferStage::SetupOcclusionData(vk::ImageView depthImageView)
+{
+    depthPyramid = std::make_unique<DepthPyramid>(depthImageView);
+
+    const BufferDescription uniformBufferDescription{
+        sizeof(Details::OcclusionUniforms),
+        vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    const size_t bufferCount = VulkanContext::swapchain->GetImages().size();
+
+    occlusionData.buffers.resize(bufferCount);
+
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+        occlusionData.buffers[i] = VulkanContext::bufferManager->CreateBuffer(
+                uniformBufferDescription, BufferCreateFlagBits::eStagingBuffer);
+    }
+
+    const BufferDescription retestBufferDescription{
+        sizeof(uint32_t) * std::max(cullingData.drawCount, 1u),
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    occlusionData.retestBuffer = VulkanContext::bufferManager->CreateBuffer(
+            retestBufferDescription, BufferCreateFlags::kNone);
+
+    SetupOcclusionDescriptorSet();
+}
+
+void GBufferStage::SetupOcclusionDescriptorSet()
+{
+    const DescriptorDescription uniformBufferDescriptorDescription{
+        1, vk::DescriptorType::eUniformBuffer,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    const DescriptorDescription sampledImageDescriptorDescription{
+        1, vk::DescriptorType::eCombinedImageSampler,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    const DescriptorDescription storageBufferDescriptorDescription{
+        1, vk::DescriptorType::eStorageBuffer,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    const DescriptorData depthPyramidData{
+        vk::DescriptorType::eCombinedImageSampler,
+        ImageInfo{
+            vk::DescriptorImageInfo(Renderer::defaultSampler, depthPyramid->GetView(), vk::ImageLayout::eGeneral)
+        }
+    };
+
+    std::vector<DescriptorSetData> multiDescriptorSetData(occlusionData.buffers.size());
+
+    for (size_t i = 0; i < occlusionData.buffers.size(); ++i)
+    {
+        multiDescriptorSetData[i] = DescriptorSetData{
+            DescriptorHelpers::GetData(occlusionData.buffers[i]),
+            depthPyramidData,
+            Details::GetStorageBufferData(occlusionData.retestBuffer)
+        };
+    }
+
+    occlusionData.descriptorSet = DescriptorHelpers::CreateMultiDescriptorSet({
+        uniformBufferDescriptorDescription,
+        sampledImageDescriptorDescription,
+        storageBufferDescriptorDescription
+    }, multiDescriptorSetData);
+}
+
+void GBufferStage::CullMeshlets(vk::CommandBuffer commandBuffer, uint32_t imageIndex, uint32_t phase) const
+{
+    const vk::Buffer indirectBuffer = cullingData.indirectBuffers[imageIndex];
+
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, indirectBuffer,
+            PipelineBarrier{ SyncScope::kIndirectCommandRead, SyncScope::kComputeShaderWrite });
+
+    if constexpr (Config::kGpuDrivenRendering)
+    {
+        const vk::Buffer countBuffer = cullingData.countBuffers[imageIndex];
+
+        if (phase == 0)
+        {
+            BufferHelpers::InsertPipelineBarrier(commandBuffer, countBuffer,
+                    PipelineBarrier{
+                        SyncScope::kIndirectCommandRead | SyncScope::kTransferRead,
+                        SyncScope::kTransferWrite
+                    });
+
+            commandBuffer.fillBuffer(countBuffer, 0, VK_WHOLE_SIZE, 0);
+
+            BufferHelpers::InsertPipelineBarrier(commandBuffer, countBuffer,
+                    PipelineBarrier{
+                        SyncScope::kTransferWrite,
+                        SyncScope::kComputeShaderRead | SyncScope::kComputeShaderWrite
+                    });
+        }
+        else
+        {
+            BufferHelpers::InsertPipelineBarrier(commandBuffer, countBuffer,
+                    PipelineBarrier{
+                        SyncScope::kIndirectCommandRead,
+                        SyncScope::kComputeShaderRead | SyncScope::kComputeShaderWrite
+                    });
+        }
+    }
+
+    if constexpr (Details::kOcclusionCulling)
+    {
+        const PipelineBarrier retestBarrier = phase == 0
+                ? PipelineBarrier{ SyncScope::kComputeShaderRead, SyncScope::kComputeShaderWrite }
+                : PipelineBarrier{ SyncScope::kComputeShaderWrite, SyncScope::kComputeShaderRead };
+
+        BufferHelpers::InsertPipelineBarrier(commandBuffer, occlusionData.retestBuffer, retestBarrier);
+    }
+
+    const Details::CullingPushConstants pushConstants{
+        camera->GetFrustumPlanes(),
+        camera->GetDescription().position,
+        cullingData.drawCount,
+        phase,
+        Details::GetLodScale(*camera)
+    };
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, cullingPipeline->Get());
+
+    commandBuffer.pushConstants<Details::CullingPushConstants>(cullingPipeline->GetLayout(),
+            vk::ShaderStageFlagBits::eCompute, 0, { pushConstants });
+
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+            cullingPipeline->GetLayout(), 0, { cullingData.descriptorSet.values[imageIndex] }, {});
+
+    if constexpr (Details::kOcclusionCulling)
+    {
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                cullingPipeline->GetLayout(), 1, { occlusionData.descriptorSet.values[imageIndex] }, {});
+    }
+
+    const uint32_t groupCount = (cullingData.drawCount + Details::kCullingWorkGroupSize - 1)
+            / Details::kCullingWorkGroupSize;
+
+    commandBuffer.dispatch(groupCount, 1, 1);
+
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, indirectBuffer,
+            PipelineBarrier{ SyncScope::kComputeShaderWrite, SyncScope::kIndirectCommandRead });
+
+    if constexpr (Config::kGpuDrivenRendering)
+    {
+        BufferHelpers::InsertPipelineBarrier(commandBuffer, cullingData.countBuffers[imageIndex],
+                PipelineBarrier{ SyncScope::kComputeShaderWrite, SyncScope::kIndirectCommandRead });
+    }
+}
+
+void GBufferStage::CopyGpuCullingStats(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+{
+    const vk::Buffer countBuffer = cullingData.countBuffers[imageIndex];
+    const vk::Buffer statsBuffer = cullingData.statsBuffers[imageIndex];
+
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, countBuffer,
+            PipelineBarrier{ SyncScope::kComputeShaderWrite, SyncScope::kTransferRead });
+
+    const vk::BufferCopy region(0, 0, VulkanContext::bufferManager->GetBufferDescription(statsBuffer).size);
+
+    commandBuffer.copyBuffer(countBuffer, statsBuffer, { region });
+
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, statsBuffer,
+            PipelineBarrier{ SyncScope::kTransferWrite, SyncScope::kHostRead });
+}
+
+void GBufferStage::ReadGpuCullingStats(uint32_t imageIndex)
+{
+    // FrameLoop waits for the fence of the frame that last used this image before recording
+    const std::vector<Scene::RenderBatch>& batches = scene->GetRenderQueue().batches;
+
+    const MemoryManager& memoryManager = *VulkanContext::memoryManager;
+    const MemoryBlock memoryBlock = memoryManager.GetBufferMemoryBlock(cullingData.statsBuffers[imageIndex]);
+
+    const uint32_t* counts = reinterpret_cast<const uint32_t*>(memoryManager.MapMemory(memoryBlock).data);
+
+    gpuCullingStats.drawCount = cullingData.drawCount;
+    gpuCullingStats.visibleDrawCount = 0;
+    gpuCullingStats.batchCount = static_cast<uint32_t>(batches.size());
+    gpuCullingStats.visibleBatchCount = 0;
+
+    for (size_t i = 0; i < batches.size(); ++i)
+    {
+        uint32_t batchDrawCount = 0;
+
+        for (uint32_t j = 0; j < Details::kCullingPhaseCount; ++j)
+        {
+            batchDrawCount += counts[i * Details::kCullingPhaseCount + j];
+        }
+
+        gpuCullingStats.visibleDrawCount += batchDrawCount;
+        gpuCullingStats.visibleBatchCount += batchDrawCount > 0 ? 1 : 0;
+    }
+
+    memoryManager.UnmapMemory(memoryBlock);
+}
@@ -8,11 +8,38 @@
 #include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
 #include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
 #include "Engine/Scene/Environment.hpp"
+#include "Engine/Camera.hpp"
+#include "Engine/Config.hpp"
 
 namespace Details
 {
     static constexpr glm::uvec2 kWorkGroupSize(8, 8);
 
+    static constexpr glm::uvec3 kClusterGridSize(16, 9, 24);
+
+    static constexpr uint32_t kClusterCount = kClusterGridSize.x * kClusterGridSize.y * kClusterGridSize.z;
+
+    static constexpr uint32_t kMaxClusterLights = 256;
+
+    static constexpr uint32_t kClusteringWorkGroupSize = 64;
+
+    struct ClusteringUniforms
+    {
+        glm::mat4 view;
+        glm::mat4 inverseProj;
+        glm::vec4 depthRange;
+    };
+
+    static std::map<std::string, uint32_t> GetClusteringDefines()
+    {
+        return std::map<std::string, uint32_t>{
+            { "CLUSTER_GRID_X", kClusterGridSize.x },
+            { "CLUSTER_GRID_Y", kClusterGridSize.y },
+            { "CLUSTER_GRID_Z", kClusterGridSize.z },
+            { "MAX_CLUSTER_LIGHTS", kMaxClusterLights }
+        };
+    }
+
     static DescriptorSet CreateGBufferDescriptorSet(const std::vector<vk::ImageView>& imageViews)
     {
         const DescriptorDescription storageImageDescriptorDescription{
@@ -51,14 +78,17 @@ namespace Details
             const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts)
     {
         const uint32_t pointLightCount = static_cast<uint32_t>(scene.GetHierarchy().pointLights.size());
-        const uint32_t materialCount = static_cast<uint32_t>(scene.GetHierarchy().materials.size());
+
+        std::map<std::string, uint32_t> defines = GetClusteringDefines();
+        defines.emplace("POINT_LIGHT_COUNT", pointLightCount);
+        defines.emplace("CLUSTERED_LIGHTING", static_cast<uint32_t>(Config::kClusteredLighting));
 
         const std::tuple specializationValues = std::make_tuple(
-                kWorkGroupSize.x, kWorkGroupSize.y, 1, materialCount);
+                kWorkGroupSize.x, kWorkGroupSize.y, 1);
 
         const ShaderModule shaderModule = VulkanContext::shaderManager->CreateShaderModule(
                 vk::ShaderStageFlagBits::eCompute, Filepath("~/Shaders/Hybrid/Lighting.comp"),
-                { std::make_pair("POINT_LIGHT_COUNT", pointLightCount) }, specializationValues);
+                defines, specializationValues);
 
         const vk::PushConstantRange pushConstantRange(
                 vk::ShaderStageFlagBits::eCompute, 0, sizeof(glm::vec3));
@@ -73,6 +103,26 @@ namespace Details
 
         return pipeline;
     }
+
+    static std::unique_ptr<ComputePipeline> CreateClusteringPipeline(
+            const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts)
+    {
+        const std::tuple specializationValues = std::make_tuple(kClusteringWorkGroupSize);
+
+        const ShaderModule shaderModule = VulkanContext::shaderManager->CreateShaderModule(
+                vk::ShaderStageFlagBits::eCompute, Filepath("~/Shaders/Hybrid/LightClustering.comp"),
+                GetClusteringDefines(), specializationValues);
+
+        const ComputePipeline::Description description{
+            shaderModule, descriptorSetLayouts, {}
+        };
+
+        std::unique_ptr<ComputePipeline> pipeline = ComputePipeline::Create(description);
+
+        VulkanContext::shaderManager->DestroyShaderModule(shaderModule);
+
+        return pipeline;
+    }
 }
 
 LightingStage::LightingStage(Scene* scene_, Camera* camera_, Environment* environment_,
@@ -86,12 +136,28 @@ LightingStage::LightingStage(Scene* scene_, Camera* camera_, Environment* enviro
 
     SetupCameraData();
     SetupLightingData();
+    SetupClusteringData();
 
     SetupPipeline();
 }
 
 LightingStage::~LightingStage()
 {
+    if (clusteringData.has_value())
+    {
+        DescriptorHelpers::DestroyMultiDescriptorSet(clusteringData->descriptorSet);
+        VulkanContext::bufferManager->DestroyBuffer(clusteringData->lightCountsBuffer);
+        VulkanContext::bufferManager->DestroyBuffer(clusteringData->lightIndicesBuffer);
+        for (const auto& buffer : clusteringData->uniformBuffers)
+        {
+            VulkanContext::bufferManager->DestroyBuffer(buffer);
+        }
+        for (const auto& buffer : clusteringData->overflowBuffers)
+        {
+            VulkanContext::bufferManager->DestroyBuffer(buffer);
+        }
+    }
+
     DescriptorHelpers::DestroyDescriptorSet(lightingData.descriptorSet);
     VulkanContext::bufferManager->DestroyBuffer(lightingData.directLightBuffer);
 
@@ -105,7 +171,7 @@ LightingStage::~LightingStage()
     DescriptorHelpers::DestroyMultiDescriptorSet(swapchainDescriptorSet);
 }
 
-void LightingStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+void LightingStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
 {
     const glm::mat4& view = camera->GetViewMatrix();
     const glm::mat4& proj = camera->GetProjectionMatrix();
@@ -115,6 +181,11 @@ void LightingStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex
     BufferHelpers::UpdateBuffer(commandBuffer, cameraData.buffers[imageIndex],
             ByteView(inverseProjView), SyncScope::kWaitForNone, SyncScope::kComputeShaderRead);
 
+    if (clusteringData.has_value())
+    {
+        BuildLightClusters(commandBuffer, imageIndex);
+    }
+
     const vk::Image swapchainImage = VulkanContext::swapchain->GetImages()[imageIndex];
     const vk::Extent2D& extent = VulkanContext::swapchain->GetExtent();
     const glm::vec3& cameraPosition = camera->GetDescription().position;
@@ -144,6 +215,11 @@ void LightingStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex
         descriptorSets.push_back(scene->GetDescriptorSets().pointLights.value().value);
     }
 
+    if (clusteringData.has_value())
+    {
+        descriptorSets.push_back(clusteringData->descriptorSet.values[imageIndex]);
+    }
+
     commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->Get());
 
     commandBuffer.pushConstants<glm::vec3>(pipeline->GetLayout(),
@@ -231,6 +307,113 @@ void LightingStage::SetupLightingData()
             descriptorSetDescription, descriptorSetData);
 }
 
+void LightingStage::SetupClusteringData()
+{
+    if (!Config::kClusteredLighting || !scene->GetDescriptorSets().pointLights.has_value())
+    {
+        return;
+    }
+
+    clusteringData = ClusteringData();
+
+    const BufferDescription uniformBufferDescription{
+        sizeof(Details::ClusteringUniforms),
+        vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    const size_t bufferCount = VulkanContext::swapchain->GetImages().size();
+
+    const BufferDescription overflowBufferDescription{
+        sizeof(uint32_t),
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+    };
+
+    clusteringData->uniformBuffers.resize(bufferCount);
+    clusteringData->overflowBuffers.resize(bufferCount);
+
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+        clusteringData->uniformBuffers[i] = VulkanContext::bufferManager->CreateBuffer(
+                uniformBufferDescription, BufferCreateFlagBits::eStagingBuffer);
+
+        clusteringData->overflowBuffers[i] = VulkanContext::bufferManager->CreateBuffer(
+                overflowBufferDescription, BufferCreateFlags::kNone);
+
+        const MemoryManager& memoryManager = *VulkanContext::memoryManager;
+        const MemoryBlock memoryBlock = memoryManager.GetBufferMemoryBlock(clusteringData->overflowBuffers[i]);
+
+        std::memset(memoryManager.MapMemory(memoryBlock).data, 0, sizeof(uint32_t));
+
+        memoryManager.UnmapMemory(memoryBlock);
+    }
+
+    const BufferDescription lightCountsBufferDescription{
+        sizeof(uint32_t) * Details::kClusterCount,
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    const BufferDescription lightIndicesBufferDescription{
+        sizeof(uint32_t) * Details::kClusterCount * Details::kMaxClusterLights,
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    clusteringData->lightCountsBuffer = VulkanContext::bufferManager->CreateBuffer(
+            lightCountsBufferDescription, BufferCreateFlags::kNone);
+
+    clusteringData->lightIndicesBuffer = VulkanContext::bufferManager->CreateBuffer(
+            lightIndicesBufferDescription, BufferCreateFlags::kNone);
+
+    const DescriptorDescription uniformBufferDescriptorDescription{
+        1, vk::DescriptorType::eUniformBuffer,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    const DescriptorDescription storageBufferDescriptorDescription{
+        1, vk::DescriptorType::eStorageBuffer,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::DescriptorBindingFlags()
+    };
+
+    const DescriptorData lightCountsData{
+        vk::DescriptorType::eStorageBuffer,
+        BufferInfo{ vk::DescriptorBufferInfo(clusteringData->lightCountsBuffer, 0, VK_WHOLE_SIZE) }
+    };
+
+    const DescriptorData lightIndicesData{
+        vk::DescriptorType::eStorageBuffer,
+        BufferInfo{ vk::DescriptorBufferInfo(clusteringData->lightIndicesBuffer, 0, VK_WHOLE_SIZE) }
+    };
+
+    std::vector<DescriptorSetData> multiDescriptorSetData(bufferCount);
+
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+        const DescriptorData overflowData{
+            vk::DescriptorType::eStorageBuffer,
+            BufferInfo{ vk::DescriptorBufferInfo(clusteringData->overflowBuffers[i], 0, VK_WHOLE_SIZE) }
+        };
+
+        multiDescriptorSetData[i] = DescriptorSetData{
+            DescriptorHelpers::GetData(clusteringData->uniformBuffers[i]),
+            lightCountsData,
+            lightIndicesData,
+            overflowData
+        };
+    }
+
+    clusteringData->descriptorSet = DescriptorHelpers::CreateMultiDescriptorSet({
+        uniformBufferDescriptorDescription,
+        storageBufferDescriptorDescription,
+        storageBufferDescriptorDescription,
+        storageBufferDescriptorDescription
+    }, multiDescriptorSetData);
+}
+
 void LightingStage::SetupPipeline()
 {
     std::vector<vk::DescriptorSetLayout> descriptorSetLayouts{
@@ -246,5 +429,87 @@ void LightingStage::SetupPipeline()
         descriptorSetLayouts.push_back(scene->GetDescriptorSets().pointLights.value().layout);
     }
 
+    if (clusteringData.has_value())
+    {
+        descriptorSetLayouts.push_back(clusteringData->descriptorSet.layout);
+
+        clusteringPipeline = Details::CreateClusteringPipeline({
+            clusteringData->descriptorSet.layout,
+            scene->GetDescriptorSets().pointLights.value().layout
+        });
+    }
+
     pipeline = Details::CreatePipeline(*scene, descriptorSetLayouts);
 }
+
+void LightingStage::BuildLightClusters(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
+{
+    ReportClusterOverflow(imageIndex);
+
+    const Camera::Description& cameraDescription = camera->GetDescription();
+
+    const float zNear = cameraDescription.zNear;
+    const float zFar = cameraDescription.zFar;
+
+    const Details::ClusteringUniforms clusteringUniforms{
+        camera->GetViewMatrix(),
+        glm::inverse(camera->GetProjectionMatrix()),
+        glm::vec4(zNear, zFar, std::log(zFar / zNear), 0.0f)
+    };
+
+    BufferHelpers::UpdateBuffer(commandBuffer, clusteringData->uniformBuffers[imageIndex],
+            ByteView(clusteringUniforms), SyncScope::kWaitForNone, SyncScope::kComputeUniformRead);
+
+    const PipelineBarrier writeBarrier{
+        SyncScope::kComputeShaderRead,
+        SyncScope::kComputeShaderWrite
+    };
+
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, clusteringData->lightCountsBuffer, writeBarrier);
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, clusteringData->lightIndicesBuffer, writeBarrier);
+
+    const std::vector<vk::DescriptorSet> descriptorSets{
+        clusteringData->descriptorSet.values[imageIndex],
+        scene->GetDescriptorSets().pointLights.value().value
+    };
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, clusteringPipeline->Get());
+
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+            clusteringPipeline->GetLayout(), 0, descriptorSets, {});
+
+    const uint32_t groupCount = (Details::kClusterCount + Details::kClusteringWorkGroupSize - 1)
+            / Details::kClusteringWorkGroupSize;
+
+    commandBuffer.dispatch(groupCount, 1, 1);
+
+    const PipelineBarrier readBarrier{
+        SyncScope::kComputeShaderWrite,
+        SyncScope::kComputeShaderRead
+    };
+
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, clusteringData->lightCountsBuffer, readBarrier);
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, clusteringData->lightIndicesBuffer, readBarrier);
+
+    BufferHelpers::InsertPipelineBarrier(commandBuffer, clusteringData->overflowBuffers[imageIndex],
+            PipelineBarrier{ SyncScope::kComputeShaderWrite, SyncScope::kHostRead });
+}
+
+void LightingStage::ReportClusterOverflow(uint32_t imageIndex)
+{
+    // FrameLoop waits for the fence of the frame that last used this image before recording
+    const MemoryManager& memoryManager = *VulkanContext::memoryManager;
+    const MemoryBlock memoryBlock = memoryManager.GetBufferMemoryBlock(clusteringData->overflowBuffers[imageIndex]);
+
+    const uint32_t maxClusterLightCount = *reinterpret_cast<const uint32_t*>(memoryManager.MapMemory(memoryBlock).data);
+
+    memoryManager.UnmapMemory(memoryBlock);
+
+    if (maxClusterLightCount > clusteringData->reportedLightCount)
+    {
+        LogW << Format("Light cluster overflow: %u lights intersect a cluster, only %u are shaded",
+                maxClusterLightCount, Details::kMaxClusterLights) << "\n";
+
+        clusteringData->reportedLightCount = maxClusterLightCount;
+    }
+}
@@ -20,6 +20,9 @@ public:
     struct Features
     {
         bool samplerAnisotropy;
+        bool multiDrawIndirect;
+        bool drawIndirectFirstInstance;
+        bool textureCompressionBC;
         bool accelerationStructure;
         bool rayTracingPipeline;
         bool descriptorIndexing;
@@ -31,6 +34,7 @@ public:
     {
         uint32_t shaderGroupHandleSize;
         uint32_t shaderGroupBaseAlignment;
+        uint32_t minScratchOffsetAlignment;
     };
 
     static std::unique_ptr<Device> Create(const Features& requiredFeatures,
@@ -158,6 +158,9 @@ namespace Details
     {
         vk::PhysicalDeviceFeatures features;
         features.setSamplerAnisotropy(deviceFeatures.samplerAnisotropy);
+        features.setMultiDrawIndirect(deviceFeatures.multiDrawIndirect);
+        features.setDrawIndirectFirstInstance(deviceFeatures.drawIndirectFirstInstance);
+        features.setTextureCompressionBC(deviceFeatures.textureCompressionBC);
 
         vk::PhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures;
         accelerationStructureFeatures.setAccelerationStructure(deviceFeatures.accelerationStructure);
@@ -197,14 +200,20 @@ namespace Details
 
     static Device::RayTracingProperties GetRayTracingProperties(vk::PhysicalDevice physicalDevice)
     {
-        const vk::PhysicalDeviceRayTracingPipelinePropertiesKHR rayTracingPipelineProperties
-                = physicalDevice.getProperties2<vk::PhysicalDeviceProperties2,
-                    vk::PhysicalDeviceRayTracingPipelinePropertiesKHR>().get<
-                    vk::PhysicalDeviceRayTracingPipelinePropertiesKHR>();
+        const auto propertiesStructureChain = physicalDevice.getProperties2<vk::PhysicalDeviceProperties2,
+                vk::PhysicalDeviceRayTracingPipelinePropertiesKHR,
+                vk::PhysicalDeviceAccelerationStructurePropertiesKHR>();
+
+        const vk::PhysicalDeviceRayTracingPipelinePropertiesKHR& rayTracingPipelineProperties
+                = propertiesStructureChain.get<vk::PhysicalDeviceRayTracingPipelinePropertiesKHR>();
+
+        const vk::PhysicalDeviceAccelerationStructurePropertiesKHR& accelerationStructureProperties
+                = propertiesStructureChain.get<vk::PhysicalDeviceAccelerationStructurePropertiesKHR>();
 
         const Device::RayTracingProperties rayTracingProperties{
             rayTracingPipelineProperties.shaderGroupHandleSize,
-            rayTracingPipelineProperties.shaderGroupBaseAlignment
+            rayTracingPipelineProperties.shaderGroupBaseAlignment,
+            accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment
         };
 
         return rayTracingProperties;
@@ -32,6 +32,11 @@ const SyncScope SyncScope::kTransferRead{
     vk::AccessFlagBits::eTransferRead
 };
 
+const SyncScope SyncScope::kHostRead{
+    vk::PipelineStageFlagBits::eHost,
+    vk::AccessFlagBits::eHostRead
+};
+
 const SyncScope SyncScope::kVerticesRead{
     vk::PipelineStageFlagBits::eVertexInput,
     vk::AccessFlagBits::eVertexAttributeRead
@@ -42,11 +47,21 @@ const SyncScope SyncScope::kIndicesRead{
     vk::AccessFlagBits::eIndexRead
 };
 
+const SyncScope SyncScope::kIndirectCommandRead{
+    vk::PipelineStageFlagBits::eDrawIndirect,
+    vk::AccessFlagBits::eIndirectCommandRead
+};
+
 const SyncScope SyncScope::kAccelerationStructureBuild{
     vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
     vk::AccessFlagBits::eAccelerationStructureReadKHR
 };
 
+const SyncScope SyncScope::kAccelerationStructureWrite{
+    vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+    vk::AccessFlagBits::eAccelerationStructureWriteKHR
+};
+
 const SyncScope SyncScope::kRayTracingShaderWrite{
     vk::PipelineStageFlagBits::eRayTracingShaderKHR,
     vk::AccessFlagBits::eShaderWrite
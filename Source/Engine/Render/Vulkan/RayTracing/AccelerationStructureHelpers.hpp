@@ -3,6 +3,7 @@
 struct GeometryVertexData
 {
     vk::Buffer buffer;
+    vk::DeviceSize offset;
     vk::Format format;
     uint32_t count;
     uint32_t stride;
@@ -11,10 +12,17 @@ struct GeometryVertexData
 struct GeometryIndexData
 {
     vk::Buffer buffer;
+    vk::DeviceSize offset;
     vk::IndexType type;
     uint32_t count;
 };
 
+struct BlasGeometryData
+{
+    GeometryVertexData vertexData;
+    GeometryIndexData indexData;
+};
+
 struct GeometryInstanceData
 {
     vk::AccelerationStructureKHR blas;
@@ -9,10 +9,18 @@ public:
 
     vk::AccelerationStructureKHR GenerateBlas(const GeometryVertexData& vertexData, const GeometryIndexData& indexData);
 
+    std::vector<vk::AccelerationStructureKHR> GenerateBlases(
+            const std::vector<BlasGeometryData>& geometries, bool compact);
+
     vk::AccelerationStructureKHR GenerateTlas(const std::vector<GeometryInstanceData>& instances);
 
     void DestroyAccelerationStructure(vk::AccelerationStructureKHR accelerationStructure);
 
+    vk::Buffer GetStorageBuffer(vk::AccelerationStructureKHR accelerationStructure) const;
+
 private:
     std::map<vk::AccelerationStructureKHR, vk::Buffer> accelerationStructures;
+
+    std::vector<vk::AccelerationStructureKHR> CompactBlases(const std::vector<vk::AccelerationStructureKHR>& blases,
+            const std::vector<vk::DeviceSize>& compactedSizes);
 };
@@ -1,18 +1,27 @@
+#include <numeric>
+
 #include "Engine/Render/Vulkan/RayTracing/AccelerationStructureManager.hpp"
 
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 
+#include "Utils/Helpers.hpp"
+#include "Utils/Logger.hpp"
+
 namespace Details
 {
     constexpr vk::AabbPositionsKHR kUnitBoundingBox(-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f);
 
+    // Upper bound of the scratch memory shared by the builds recorded between two barriers
+    constexpr vk::DeviceSize kMaxScratchArenaSize = 64 * 1024 * 1024;
+
     using AccelerationStructureEntry = std::pair<vk::AccelerationStructureKHR, vk::Buffer>;
 
     static vk::AccelerationStructureBuildSizesInfoKHR GetBuildSizesInfo(vk::AccelerationStructureTypeKHR type,
+            vk::BuildAccelerationStructureFlagsKHR buildFlags,
             const vk::AccelerationStructureGeometryKHR& geometry, uint32_t primitiveCount)
     {
         const vk::AccelerationStructureBuildGeometryInfoKHR buildInfo(
-                type, vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace,
+                type, buildFlags,
                 vk::BuildAccelerationStructureModeKHR::eBuild,
                 nullptr, nullptr, 1, &geometry, nullptr, nullptr);
 
@@ -74,14 +83,14 @@ namespace Details
     static AccelerationStructureEntry GenerateAccelerationStructure(vk::AccelerationStructureTypeKHR type,
             const vk::AccelerationStructureGeometryKHR& geometry, uint32_t primitiveCount)
     {
-        const vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo
-                = Details::GetBuildSizesInfo(type, geometry, primitiveCount);
+        const vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo = Details::GetBuildSizesInfo(
+                type, vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace, geometry, primitiveCount);
 
         const vk::Buffer storageBuffer = Details::CreateAccelerationStructureBuffer(
                 buildSizesInfo.accelerationStructureSize, vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR);
 
         const vk::Buffer buildScratchBuffer = Details::CreateAccelerationStructureBuffer(
-                buildSizesInfo.buildScratchSize, vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR);
+                buildSizesInfo.buildScratchSize, vk::BufferUsageFlagBits::eStorageBuffer);
 
         const vk::AccelerationStructureCreateInfoKHR createInfo({}, storageBuffer, 0,
                 buildSizesInfo.accelerationStructureSize, type, vk::DeviceAddress());
@@ -109,6 +118,65 @@ namespace Details
 
         return std::make_pair(accelerationStructure, storageBuffer);
     }
+
+    static vk::AccelerationStructureGeometryKHR GetTrianglesGeometry(const BlasGeometryData& geometryData)
+    {
+        const auto& [vertexData, indexData] = geometryData;
+
+        const vk::AccelerationStructureGeometryTrianglesDataKHR trianglesData(
+                vertexData.format, VulkanContext::device->GetAddress(vertexData.buffer) + vertexData.offset,
+                vertexData.stride, vertexData.count - 1, indexData.type,
+                VulkanContext::device->GetAddress(indexData.buffer) + indexData.offset, nullptr);
+
+        const vk::AccelerationStructureGeometryDataKHR vkGeometryData(trianglesData);
+
+        return vk::AccelerationStructureGeometryKHR(
+                vk::GeometryTypeKHR::eTriangles, vkGeometryData,
+                vk::GeometryFlagsKHR());
+    }
+
+    static vk::DeviceSize AlignSize(vk::DeviceSize size, vk::DeviceSize alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // Fits all builds at once when possible, otherwise the arena is reused between batches of builds
+    static vk::DeviceSize GetScratchArenaSize(const std::vector<vk::DeviceSize>& scratchSizes)
+    {
+        const vk::DeviceSize totalSize = std::accumulate(scratchSizes.begin(), scratchSizes.end(), vk::DeviceSize(0));
+
+        if (totalSize <= kMaxScratchArenaSize)
+        {
+            return totalSize;
+        }
+
+        const vk::DeviceSize maxSize = *std::max_element(scratchSizes.begin(), scratchSizes.end());
+
+        return std::max(maxSize, kMaxScratchArenaSize);
+    }
+
+    static vk::QueryPool CreateCompactedSizeQueryPool(uint32_t queryCount)
+    {
+        const vk::QueryPoolCreateInfo createInfo({},
+                vk::QueryType::eAccelerationStructureCompactedSizeKHR, queryCount);
+
+        const auto [result, queryPool] = VulkanContext::device->Get().createQueryPool(createInfo);
+
+        Assert(result == vk::Result::eSuccess);
+
+        return queryPool;
+    }
+
+    static std::vector<vk::DeviceSize> RetrieveCompactedSizes(vk::QueryPool queryPool, uint32_t queryCount)
+    {
+        const auto [result, compactedSizes] = VulkanContext::device->Get().getQueryPoolResults<vk::DeviceSize>(
+                queryPool, 0, queryCount, queryCount * sizeof(vk::DeviceSize), sizeof(vk::DeviceSize),
+                vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+
+        Assert(result == vk::Result::eSuccess);
+
+        return compactedSizes;
+    }
 }
 
 vk::AccelerationStructureKHR AccelerationStructureManager::GenerateBoundingBoxBlas()
@@ -142,26 +210,157 @@ vk::AccelerationStructureKHR AccelerationStructureManager::GenerateBoundingBoxBl
 vk::AccelerationStructureKHR AccelerationStructureManager::GenerateBlas(
         const GeometryVertexData& vertexData, const GeometryIndexData& indexData)
 {
+    return GenerateBlases({ BlasGeometryData{ vertexData, indexData } }, false).front();
+}
+
+std::vector<vk::AccelerationStructureKHR> AccelerationStructureManager::GenerateBlases(
+        const std::vector<BlasGeometryData>& geometries, bool compact)
+{
+    if (geometries.empty())
+    {
+        return {};
+    }
+
     const vk::AccelerationStructureTypeKHR type = vk::AccelerationStructureTypeKHR::eBottomLevel;
 
-    const vk::AccelerationStructureGeometryTrianglesDataKHR trianglesData(
-            vertexData.format, VulkanContext::device->GetAddress(vertexData.buffer),
-            vertexData.stride, vertexData.count - 1, indexData.type,
-            VulkanContext::device->GetAddress(indexData.buffer), nullptr);
+    const vk::DeviceSize scratchAlignment = VulkanContext::device->GetRayTracingProperties().minScratchOffsetAlignment;
 
-    const vk::AccelerationStructureGeometryDataKHR geometryData(trianglesData);
+    const vk::BuildAccelerationStructureFlagsKHR buildFlags = compact
+            ? vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace
+            | vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction
+            : vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
 
-    const vk::AccelerationStructureGeometryKHR geometry(
-            vk::GeometryTypeKHR::eTriangles, geometryData,
-            vk::GeometryFlagsKHR());
+    const size_t blasCount = geometries.size();
 
-    const uint32_t primitiveCount = indexData.count / 3;
+    std::vector<vk::AccelerationStructureGeometryKHR> vkGeometries(blasCount);
+    std::vector<vk::AccelerationStructureBuildRangeInfoKHR> rangeInfos(blasCount);
+    std::vector<vk::AccelerationStructureBuildGeometryInfoKHR> buildInfos(blasCount);
+    std::vector<vk::DeviceSize> scratchSizes(blasCount);
 
-    const auto [blas, storageBuffer] = Details::GenerateAccelerationStructure(type, geometry, primitiveCount);
+    std::vector<vk::AccelerationStructureKHR> blases(blasCount);
 
-    accelerationStructures.emplace(blas, storageBuffer);
+    for (size_t i = 0; i < blasCount; ++i)
+    {
+        const uint32_t primitiveCount = geometries[i].indexData.count / 3;
 
-    return blas;
+        vkGeometries[i] = Details::GetTrianglesGeometry(geometries[i]);
+        rangeInfos[i] = vk::AccelerationStructureBuildRangeInfoKHR(primitiveCount, 0, 0, 0);
+
+        const vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo
+                = Details::GetBuildSizesInfo(type, buildFlags, vkGeometries[i], primitiveCount);
+
+        const vk::Buffer storageBuffer = Details::CreateAccelerationStructureBuffer(
+                buildSizesInfo.accelerationStructureSize, vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR);
+
+        const vk::AccelerationStructureCreateInfoKHR createInfo({}, storageBuffer, 0,
+                buildSizesInfo.accelerationStructureSize, type, vk::DeviceAddress());
+
+        const auto [result, blas] = VulkanContext::device->Get().createAccelerationStructureKHR(createInfo);
+
+        Assert(result == vk::Result::eSuccess);
+
+        buildInfos[i] = vk::AccelerationStructureBuildGeometryInfoKHR(
+                type, buildFlags,
+                vk::BuildAccelerationStructureModeKHR::eBuild,
+                nullptr, blas, 1, &vkGeometries[i], nullptr, vk::DeviceAddress());
+
+        scratchSizes[i] = Details::AlignSize(buildSizesInfo.buildScratchSize, scratchAlignment);
+
+        blases[i] = blas;
+
+        accelerationStructures.emplace(blas, storageBuffer);
+    }
+
+    const vk::DeviceSize scratchArenaSize = Details::GetScratchArenaSize(scratchSizes);
+
+    // Buffer device address is not guaranteed to satisfy the scratch offset alignment
+    const vk::Buffer scratchBuffer = Details::CreateAccelerationStructureBuffer(
+            scratchArenaSize + scratchAlignment, vk::BufferUsageFlagBits::eStorageBuffer);
+
+    const vk::DeviceAddress scratchAddress = Details::AlignSize(
+            VulkanContext::device->GetAddress(scratchBuffer), scratchAlignment);
+
+    const uint32_t queryCount = static_cast<uint32_t>(blasCount);
+
+    const vk::QueryPool queryPool = compact ? Details::CreateCompactedSizeQueryPool(queryCount) : vk::QueryPool();
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            if (compact)
+            {
+                commandBuffer.resetQueryPool(queryPool, 0, queryCount);
+            }
+
+            std::vector<vk::AccelerationStructureBuildGeometryInfoKHR> batchBuildInfos;
+            std::vector<const vk::AccelerationStructureBuildRangeInfoKHR*> batchRangeInfos;
+
+            vk::DeviceSize scratchOffset = 0;
+
+            const auto buildBatch = [&]()
+                {
+                    commandBuffer.buildAccelerationStructuresKHR(batchBuildInfos, batchRangeInfos);
+
+                    const PipelineBarrier barrier{
+                        SyncScope::kAccelerationStructureWrite,
+                        SyncScope::kAccelerationStructureBuild | SyncScope::kAccelerationStructureWrite
+                    };
+
+                    BufferHelpers::InsertPipelineBarrier(commandBuffer, scratchBuffer, barrier);
+
+                    batchBuildInfos.clear();
+                    batchRangeInfos.clear();
+
+                    scratchOffset = 0;
+                };
+
+            for (size_t i = 0; i < blasCount; ++i)
+            {
+                if (scratchOffset + scratchSizes[i] > scratchArenaSize)
+                {
+                    buildBatch();
+                }
+
+                buildInfos[i].scratchData.deviceAddress = scratchAddress + scratchOffset;
+
+                batchBuildInfos.push_back(buildInfos[i]);
+                batchRangeInfos.push_back(&rangeInfos[i]);
+
+                scratchOffset += scratchSizes[i];
+            }
+
+            if (!batchBuildInfos.empty())
+            {
+                commandBuffer.buildAccelerationStructuresKHR(batchBuildInfos, batchRangeInfos);
+            }
+
+            if (compact)
+            {
+                const vk::MemoryBarrier memoryBarrier(
+                        SyncScope::kAccelerationStructureWrite.access,
+                        SyncScope::kAccelerationStructureBuild.access);
+
+                commandBuffer.pipelineBarrier(
+                        SyncScope::kAccelerationStructureWrite.stages,
+                        SyncScope::kAccelerationStructureBuild.stages,
+                        vk::DependencyFlags(), { memoryBarrier }, {}, {});
+
+                commandBuffer.writeAccelerationStructuresPropertiesKHR(blases,
+                        vk::QueryType::eAccelerationStructureCompactedSizeKHR, queryPool, 0);
+            }
+        });
+
+    VulkanContext::bufferManager->DestroyBuffer(scratchBuffer);
+
+    if (compact)
+    {
+        const std::vector<vk::DeviceSize> compactedSizes = Details::RetrieveCompactedSizes(queryPool, queryCount);
+
+        VulkanContext::device->Get().destroyQueryPool(queryPool);
+
+        return CompactBlases(blases, compactedSizes);
+    }
+
+    return blases;
 }
 
 vk::AccelerationStructureKHR AccelerationStructureManager::GenerateTlas(
@@ -191,6 +390,59 @@ vk::AccelerationStructureKHR AccelerationStructureManager::GenerateTlas(
     return tlas;
 }
 
+std::vector<vk::AccelerationStructureKHR> AccelerationStructureManager::CompactBlases(
+        const std::vector<vk::AccelerationStructureKHR>& blases, const std::vector<vk::DeviceSize>& compactedSizes)
+{
+    const BufferManager& bufferManager = *VulkanContext::bufferManager;
+
+    std::vector<vk::AccelerationStructureKHR> compactedBlases(blases.size());
+
+    vk::DeviceSize originalSize = 0;
+    vk::DeviceSize compactedSize = 0;
+
+    for (size_t i = 0; i < blases.size(); ++i)
+    {
+        const vk::Buffer storageBuffer = Details::CreateAccelerationStructureBuffer(
+                compactedSizes[i], vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR);
+
+        const vk::AccelerationStructureCreateInfoKHR createInfo({}, storageBuffer, 0,
+                compactedSizes[i], vk::AccelerationStructureTypeKHR::eBottomLevel, vk::DeviceAddress());
+
+        const auto [result, compactedBlas] = VulkanContext::device->Get().createAccelerationStructureKHR(createInfo);
+
+        Assert(result == vk::Result::eSuccess);
+
+        compactedBlases[i] = compactedBlas;
+
+        accelerationStructures.emplace(compactedBlas, storageBuffer);
+
+        originalSize += bufferManager.GetBufferDescription(accelerationStructures.at(blases[i])).size;
+        compactedSize += compactedSizes[i];
+    }
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            for (size_t i = 0; i < blases.size(); ++i)
+            {
+                const vk::CopyAccelerationStructureInfoKHR copyInfo(blases[i], compactedBlases[i],
+                        vk::CopyAccelerationStructureModeKHR::eCompact);
+
+                commandBuffer.copyAccelerationStructureKHR(copyInfo);
+            }
+        });
+
+    for (const auto& blas : blases)
+    {
+        DestroyAccelerationStructure(blas);
+    }
+
+    LogI << Format("BLAS compaction: %zu structures, %.2f MB -> %.2f MB", blases.size(),
+            static_cast<float>(originalSize) / static_cast<float>(Numbers::kMegabyte),
+            static_cast<float>(compactedSize) / static_cast<float>(Numbers::kMegabyte)) << "\n";
+
+    return compactedBlases;
+}
+
 void AccelerationStructureManager::DestroyAccelerationStructure(vk::AccelerationStructureKHR accelerationStructure)
 {
     const auto it = accelerationStructures.find(accelerationStructure);
@@ -201,3 +453,8 @@ void AccelerationStructureManager::DestroyAccelerationStructure(vk::Acceleration
 
     accelerationStructures.erase(it);
 }
+
+vk::Buffer AccelerationStructureManager::GetStorageBuffer(vk::AccelerationStructureKHR accelerationStructure) const
+{
+    return accelerationStructures.at(accelerationStructure);
+}
@@ -23,6 +23,8 @@ OVERLOAD_LOGIC_OPERATORS(BufferCreateFlags, BufferCreateFlagBits)
 
 namespace BufferHelpers
 {
+    using BufferData = std::pair<vk::BufferUsageFlags, ByteView>;
+
     void InsertPipelineBarrier(vk::CommandBuffer commandBuffer,
             vk::Buffer buffer, const PipelineBarrier& barrier);
 
@@ -32,4 +34,6 @@ namespace BufferHelpers
             const ByteView& data, const SyncScope& waitedScope, const SyncScope& blockedScope);
 
     vk::Buffer CreateBufferWithData(vk::BufferUsageFlags bufferUsage, const ByteView& data);
+
+    std::vector<vk::Buffer> CreateBuffersWithData(const std::vector<BufferData>& buffersData);
 }
@@ -91,6 +91,8 @@ namespace ImageHelpers
 
     bool IsDepthFormat(vk::Format format);
 
+    bool IsCompressedFormat(vk::Format format);
+
     uint32_t GetTexelSize(vk::Format format);
 
     vk::ImageAspectFlags GetImageAspect(vk::Format format);
@@ -113,6 +115,8 @@ namespace ImageHelpers
 
     uint32_t CalculateMipLevelTexelCount(const ImageDescription& description, uint32_t mipLevel);
 
+    vk::DeviceSize CalculateDataSize(const vk::Extent3D& extent, uint32_t layerCount, vk::Format format);
+
     vk::DeviceSize CalculateMipLevelSize(const ImageDescription& description, uint32_t mipLevel);
 
     Texture CreateRenderTarget(vk::Format format, const vk::Extent2D& extent,
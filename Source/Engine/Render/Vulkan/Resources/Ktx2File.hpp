@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
+#include "Engine/Filesystem/MappedFile.hpp"
+
+#include "Utils/DataHelpers.hpp"
+
+class Ktx2File
+{
+public:
+    struct Description
+    {
+        ImageType type;
+        vk::Format format;
+        vk::Extent3D extent;
+        uint32_t mipLevelCount;
+        uint32_t layerCount;
+    };
+
+    Ktx2File(const Filepath& filepath);
+
+    Ktx2File(const Ktx2File&) = delete;
+    Ktx2File& operator=(const Ktx2File&) = delete;
+
+    const Description& GetDescription() const { return description; }
+
+    const std::vector<ByteView>& GetMipLevels() const { return mipLevels; }
+
+private:
+    std::unique_ptr<MappedFile> file;
+
+    Description description;
+
+    std::vector<Bytes> inflatedMipLevels;
+
+    std::vector<ByteView> mipLevels;
+};
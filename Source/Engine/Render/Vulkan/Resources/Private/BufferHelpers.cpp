@@ -69,3 +69,31 @@ vk::Buffer BufferHelpers::CreateBufferWithData(vk::BufferUsageFlags usage, const
 
     return buffer;
 }
+
+std::vector<vk::Buffer> BufferHelpers::CreateBuffersWithData(const std::vector<BufferData>& buffersData)
+{
+    std::vector<vk::Buffer> buffers;
+    buffers.reserve(buffersData.size());
+
+    for (const auto& [usage, data] : buffersData)
+    {
+        const BufferDescription bufferDescription{
+            data.size,
+            usage | vk::BufferUsageFlagBits::eTransferDst,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        };
+
+        buffers.push_back(VulkanContext::bufferManager->CreateBuffer(
+                bufferDescription, BufferCreateFlagBits::eStagingBuffer));
+    }
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            for (size_t i = 0; i < buffers.size(); ++i)
+            {
+                VulkanContext::bufferManager->UpdateBuffer(commandBuffer, buffers[i], buffersData[i].second);
+            }
+        });
+
+    return buffers;
+}
@@ -6,6 +6,8 @@
 
 namespace Details
 {
+    constexpr uint32_t kCompressedBlockDimension = 4;
+
     constexpr std::array<glm::vec4, 6> kMipLevelsColors{
         glm::vec4(1.0f, 0.0f, 0.0f, 1.0f),
         glm::vec4(1.0f, 1.0f, 0.0f, 1.0f),
@@ -40,6 +42,32 @@ bool ImageHelpers::IsDepthFormat(vk::Format format)
     }
 }
 
+bool ImageHelpers::IsCompressedFormat(vk::Format format)
+{
+    switch (format)
+    {
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc2UnormBlock:
+    case vk::Format::eBc2SrgbBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+    case vk::Format::eBc4UnormBlock:
+    case vk::Format::eBc4SnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc5SnormBlock:
+    case vk::Format::eBc6HUfloatBlock:
+    case vk::Format::eBc6HSfloatBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return true;
+    default:
+        return false;
+    }
+}
+
 uint32_t ImageHelpers::GetTexelSize(vk::Format format)
 {
     switch (format)
@@ -231,6 +259,26 @@ uint32_t ImageHelpers::GetTexelSize(vk::Format format)
     case vk::Format::eD32SfloatS8Uint:
         return 5;
 
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc4UnormBlock:
+    case vk::Format::eBc4SnormBlock:
+        return 8;
+
+    case vk::Format::eBc2UnormBlock:
+    case vk::Format::eBc2SrgbBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc5SnormBlock:
+    case vk::Format::eBc6HUfloatBlock:
+    case vk::Format::eBc6HSfloatBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return 16;
+
     default:
         Assert(false);
         return 0;
@@ -326,9 +374,29 @@ uint32_t ImageHelpers::CalculateMipLevelTexelCount(const ImageDescription& descr
     return extent.width * extent.height * extent.depth * description.layerCount;
 }
 
+vk::DeviceSize ImageHelpers::CalculateDataSize(const vk::Extent3D& extent, uint32_t layerCount, vk::Format format)
+{
+    vk::Extent3D texelBlockCount = extent;
+
+    if (IsCompressedFormat(format))
+    {
+        texelBlockCount.width = (extent.width + Details::kCompressedBlockDimension - 1)
+                / Details::kCompressedBlockDimension;
+        texelBlockCount.height = (extent.height + Details::kCompressedBlockDimension - 1)
+                / Details::kCompressedBlockDimension;
+    }
+
+    const vk::DeviceSize texelBlockTotal = static_cast<vk::DeviceSize>(texelBlockCount.width)
+            * texelBlockCount.height * texelBlockCount.depth * layerCount;
+
+    return texelBlockTotal * GetTexelSize(format);
+}
+
 vk::DeviceSize ImageHelpers::CalculateMipLevelSize(const ImageDescription& description, uint32_t mipLevel)
 {
-    return CalculateMipLevelTexelCount(description, mipLevel) * GetTexelSize(description.format);
+    const vk::Extent3D extent = CalculateMipLevelExtent(description.extent, mipLevel);
+
+    return CalculateDataSize(extent, description.layerCount, description.format);
 }
 
 Texture ImageHelpers::CreateRenderTarget(vk::Format format, const vk::Extent2D& extent,
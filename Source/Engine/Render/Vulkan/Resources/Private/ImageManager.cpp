@@ -55,6 +55,18 @@ namespace Details
 
     static vk::DeviceSize CalculateStagingBufferSize(const ImageDescription& description)
     {
+        if (ImageHelpers::IsCompressedFormat(description.format))
+        {
+            vk::DeviceSize size = 0;
+
+            for (uint32_t i = 0; i < description.mipLevelCount; ++i)
+            {
+                size += ImageHelpers::CalculateMipLevelSize(description, i);
+            }
+
+            return size;
+        }
+
         return ImageHelpers::CalculateMipLevelSize(description, 0) * 2;
     }
 
@@ -79,11 +91,6 @@ namespace Details
 
         return std::get<ByteView>(data);
     }
-
-    static size_t CalculateDataSize(const vk::Extent3D& extent, uint32_t layerCount, vk::Format format)
-    {
-        return extent.width * extent.height * extent.depth * layerCount * ImageHelpers::GetTexelSize(format);
-    }
 }
 
 vk::Image ImageManager::CreateImage(const ImageDescription& description, ImageCreateFlags createFlags)
@@ -173,7 +180,7 @@ void ImageManager::UpdateImage(vk::CommandBuffer commandBuffer, vk::Image image,
         {
             const ByteView data = Details::RetrieveByteView(imageUpdate.data);
 
-            const size_t expectedSize = Details::CalculateDataSize(imageUpdate.extent,
+            const vk::DeviceSize expectedSize = ImageHelpers::CalculateDataSize(imageUpdate.extent,
                     imageUpdate.layers.layerCount, description.format);
 
             Assert(data.size == expectedSize);
@@ -0,0 +1,193 @@
+#include <stb_image.h>
+
+#include "Engine/Render/Vulkan/Resources/Ktx2File.hpp"
+
+#include "Utils/Assert.hpp"
+#include "Utils/Helpers.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/ThreadHelpers.hpp"
+#include "Utils/TimeHelpers.hpp"
+
+namespace Details
+{
+    enum class SupercompressionScheme : uint32_t
+    {
+        eNone = 0,
+        eBasisLZ = 1,
+        eZstandard = 2,
+        eZLIB = 3,
+    };
+
+    struct Header
+    {
+        uint8_t identifier[12];
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        SupercompressionScheme supercompressionScheme;
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+
+    struct LevelIndex
+    {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+
+    static_assert(sizeof(Header) == 80);
+    static_assert(sizeof(LevelIndex) == 24);
+
+    static constexpr uint8_t kIdentifier[12] = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+
+    static ImageType GetImageType(const Header& header)
+    {
+        if (header.faceCount == ImageHelpers::kCubeFaceCount)
+        {
+            Assert(header.layerCount <= 1);
+            Assert(header.pixelDepth <= 1);
+
+            return ImageType::eCube;
+        }
+
+        Assert(header.faceCount == 1);
+
+        if (header.pixelDepth > 1)
+        {
+            return ImageType::e3D;
+        }
+
+        if (header.pixelHeight == 0)
+        {
+            return ImageType::e1D;
+        }
+
+        return ImageType::e2D;
+    }
+
+    static Ktx2File::Description GetDescription(const Header& header)
+    {
+        const vk::Extent3D extent(header.pixelWidth,
+                std::max(header.pixelHeight, 1u), std::max(header.pixelDepth, 1u));
+
+        return Ktx2File::Description{
+            GetImageType(header),
+            static_cast<vk::Format>(header.vkFormat),
+            extent,
+            std::max(header.levelCount, 1u),
+            std::max(header.layerCount, 1u) * header.faceCount
+        };
+    }
+
+    static Bytes Inflate(const ByteView& data, size_t size)
+    {
+        Bytes result(size);
+
+        const int32_t inflatedSize = stbi_zlib_decode_buffer(
+                reinterpret_cast<char*>(result.data()), static_cast<int32_t>(result.size()),
+                reinterpret_cast<const char*>(data.data), static_cast<int32_t>(data.size));
+
+        Assert(inflatedSize == static_cast<int32_t>(size));
+
+        return result;
+    }
+}
+
+Ktx2File::Ktx2File(const Filepath& filepath)
+    : file(MappedFile::Create(filepath))
+{
+    Assert(file);
+
+    const ByteView& data = file->GetData();
+
+    Assert(data.size >= sizeof(Details::Header));
+
+    const Details::Header header = *reinterpret_cast<const Details::Header*>(data.data);
+
+    Assert(std::equal(std::begin(header.identifier), std::end(header.identifier), std::begin(Details::kIdentifier)));
+
+    description = Details::GetDescription(header);
+
+    Assert(description.format != vk::Format::eUndefined);
+    Assert(description.mipLevelCount <= ImageHelpers::CalculateMipLevelCount(description.extent));
+
+    const size_t levelIndexOffset = sizeof(Details::Header);
+    const size_t levelIndexSize = sizeof(Details::LevelIndex) * description.mipLevelCount;
+
+    Assert(levelIndexOffset + levelIndexSize <= data.size);
+
+    const Details::LevelIndex* levelIndex
+            = reinterpret_cast<const Details::LevelIndex*>(data.data + levelIndexOffset);
+
+    mipLevels.resize(description.mipLevelCount);
+
+    for (uint32_t i = 0; i < description.mipLevelCount; ++i)
+    {
+        Assert(levelIndex[i].byteOffset + levelIndex[i].byteLength <= data.size);
+
+        mipLevels[i] = ByteView(data.data + levelIndex[i].byteOffset, levelIndex[i].byteLength);
+    }
+
+    switch (header.supercompressionScheme)
+    {
+    case Details::SupercompressionScheme::eNone:
+        break;
+    case Details::SupercompressionScheme::eZLIB:
+    {
+        const Stopwatch stopwatch;
+
+        const uint32_t threadCount = ThreadHelpers::GetThreadCount();
+
+        inflatedMipLevels.resize(description.mipLevelCount);
+
+        ThreadHelpers::ParallelFor(mipLevels.size(), threadCount, [&](size_t i)
+            {
+                inflatedMipLevels[i] = Details::Inflate(mipLevels[i],
+                        static_cast<size_t>(levelIndex[i].uncompressedByteLength));
+            });
+
+        size_t compressedSize = 0;
+        size_t inflatedSize = 0;
+
+        for (size_t i = 0; i < mipLevels.size(); ++i)
+        {
+            compressedSize += mipLevels[i].size;
+            inflatedSize += inflatedMipLevels[i].size();
+
+            mipLevels[i] = ByteView(inflatedMipLevels[i]);
+        }
+
+        const float compressedMegabytes = static_cast<float>(compressedSize) / static_cast<float>(Numbers::kMegabyte);
+        const float inflatedMegabytes = static_cast<float>(inflatedSize) / static_cast<float>(Numbers::kMegabyte);
+
+        LogI << Format("KTX2 levels inflated: %zu levels, %.2f MB -> %.2f MB in %.2f ms (%u threads)",
+                mipLevels.size(), compressedMegabytes, inflatedMegabytes,
+                stopwatch.GetElapsedMiliseconds(), threadCount) << "\n";
+        break;
+    }
+    default:
+        LogE << "Unsupported KTX2 supercompression scheme: " << filepath.GetAbsolute() << "\n";
+        Assert(false);
+        break;
+    }
+
+    for (uint32_t i = 0; i < description.mipLevelCount; ++i)
+    {
+        const vk::Extent3D mipLevelExtent = ImageHelpers::CalculateMipLevelExtent(description.extent, i);
+
+        Assert(mipLevels[i].size == ImageHelpers::CalculateDataSize(
+                mipLevelExtent, description.layerCount, description.format));
+    }
+}
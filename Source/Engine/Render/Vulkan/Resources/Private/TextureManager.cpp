@@ -3,6 +3,7 @@
 
 #include "Engine/Render/Vulkan/Resources/TextureManager.hpp"
 
+#include "Engine/Render/Vulkan/Resources/Ktx2File.hpp"
 #include "Engine/Render/Renderer.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Render/Vulkan/VulkanConfig.hpp"
@@ -12,33 +13,22 @@ namespace Details
     static constexpr vk::Format kLDRFormat = vk::Format::eR8G8B8A8Unorm;
     static constexpr vk::Format kHDRFormat = vk::Format::eR32G32B32A32Sfloat;
 
-    static void UpdateImage(vk::CommandBuffer commandBuffer, vk::Image image,
-            const ImageDescription& description, const ByteView& data)
+    static vk::ImageViewType GetImageViewType(const Ktx2File::Description& description)
     {
-        Assert(data.size == ImageHelpers::CalculateMipLevelSize(description, 0));
-
-        const vk::ImageSubresourceRange fullImage(vk::ImageAspectFlagBits::eColor,
-                0, description.mipLevelCount, 0, description.layerCount);
-
-        const vk::ImageSubresourceLayers baseMipLevel = ImageHelpers::GetSubresourceLayers(fullImage, 0);
-
-        const ImageUpdate imageUpdate{
-            baseMipLevel, { 0, 0, 0 },
-            description.extent, data
-        };
-
-        const ImageLayoutTransition layoutTransition{
-            vk::ImageLayout::eUndefined,
-            vk::ImageLayout::eTransferDstOptimal,
-            PipelineBarrier{
-                SyncScope::kWaitForNone,
-                SyncScope::kTransferWrite
-            }
-        };
-
-        ImageHelpers::TransitImageLayout(commandBuffer, image, fullImage, layoutTransition);
-
-        VulkanContext::imageManager->UpdateImage(commandBuffer, image, { imageUpdate });
+        switch (description.type)
+        {
+        case ImageType::e1D:
+            return description.layerCount > 1 ? vk::ImageViewType::e1DArray : vk::ImageViewType::e1D;
+        case ImageType::e2D:
+            return description.layerCount > 1 ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D;
+        case ImageType::e3D:
+            return vk::ImageViewType::e3D;
+        case ImageType::eCube:
+            return vk::ImageViewType::eCube;
+        default:
+            Assert(false);
+            return vk::ImageViewType::e2D;
+        }
     }
 
     static void TransitImageLayoutAfterMipLevelsGenerating(vk::CommandBuffer commandBuffer,
@@ -78,10 +68,104 @@ namespace Details
             ImageHelpers::TransitImageLayout(commandBuffer, image, lastMipLevel, layoutTransition);
         }
     }
+
+    // Uploads a full mip chain, or only the base level and generates the rest with blits
+    static Texture CreateTextureWithData(const ImageDescription& description,
+            vk::ImageViewType viewType, const std::vector<ByteView>& mipLevelsData)
+    {
+        const uint32_t dataMipLevelCount = static_cast<uint32_t>(mipLevelsData.size());
+
+        const bool generateMipLevels = dataMipLevelCount < description.mipLevelCount;
+
+        Assert(dataMipLevelCount == description.mipLevelCount || dataMipLevelCount == 1);
+
+        const vk::Image image = VulkanContext::imageManager->CreateImage(description,
+                ImageCreateFlagBits::eStagingBuffer);
+
+        const vk::ImageSubresourceRange fullImage(vk::ImageAspectFlagBits::eColor,
+                0, description.mipLevelCount, 0, description.layerCount);
+
+        std::vector<ImageUpdate> imageUpdates;
+        imageUpdates.reserve(dataMipLevelCount);
+
+        for (uint32_t i = 0; i < dataMipLevelCount; ++i)
+        {
+            Assert(mipLevelsData[i].size == ImageHelpers::CalculateMipLevelSize(description, i));
+
+            const ImageUpdate imageUpdate{
+                ImageHelpers::GetSubresourceLayers(fullImage, i), { 0, 0, 0 },
+                ImageHelpers::CalculateMipLevelExtent(description.extent, i),
+                mipLevelsData[i]
+            };
+
+            imageUpdates.push_back(imageUpdate);
+        }
+
+        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+            {
+                {
+                    const ImageLayoutTransition layoutTransition{
+                        vk::ImageLayout::eUndefined,
+                        vk::ImageLayout::eTransferDstOptimal,
+                        PipelineBarrier{
+                            SyncScope::kWaitForNone,
+                            SyncScope::kTransferWrite
+                        }
+                    };
+
+                    ImageHelpers::TransitImageLayout(commandBuffer, image, fullImage, layoutTransition);
+                }
+
+                VulkanContext::imageManager->UpdateImage(commandBuffer, image, imageUpdates);
+
+                if (generateMipLevels)
+                {
+                    const vk::ImageSubresourceRange baseMipLevel(vk::ImageAspectFlagBits::eColor,
+                            0, 1, 0, description.layerCount);
+
+                    const ImageLayoutTransition layoutTransition{
+                        vk::ImageLayout::eTransferDstOptimal,
+                        vk::ImageLayout::eTransferSrcOptimal,
+                        PipelineBarrier{
+                            SyncScope::kTransferWrite,
+                            SyncScope::kTransferRead
+                        }
+                    };
+
+                    ImageHelpers::TransitImageLayout(commandBuffer, image, baseMipLevel, layoutTransition);
+
+                    ImageHelpers::GenerateMipLevels(commandBuffer, image, description.extent, fullImage);
+
+                    TransitImageLayoutAfterMipLevelsGenerating(commandBuffer, image, fullImage);
+                }
+                else
+                {
+                    const ImageLayoutTransition layoutTransition{
+                        vk::ImageLayout::eTransferDstOptimal,
+                        vk::ImageLayout::eShaderReadOnlyOptimal,
+                        PipelineBarrier{
+                            SyncScope::kTransferWrite,
+                            SyncScope::kBlockNone
+                        }
+                    };
+
+                    ImageHelpers::TransitImageLayout(commandBuffer, image, fullImage, layoutTransition);
+                }
+            });
+
+        const vk::ImageView view = VulkanContext::imageManager->CreateView(image, viewType, fullImage);
+
+        return Texture{ image, view };
+    }
 }
 
 Texture TextureManager::CreateTexture(const Filepath& filepath) const
 {
+    if (filepath.GetExtension() == ".ktx2")
+    {
+        return CreateTexture(Ktx2File(filepath));
+    }
+
     ByteAccess data;
     int32_t width, height;
 
@@ -110,69 +194,66 @@ Texture TextureManager::CreateTexture(const Filepath& filepath) const
     return texture;
 }
 
-Texture TextureManager::CreateTexture(vk::Format format, const vk::Extent2D& extent, const ByteView& data) const
+Texture TextureManager::CreateTexture(const Ktx2File& file) const
 {
-    const vk::Extent3D extent3D = VulkanHelpers::GetExtent3D(extent);
-    const uint32_t mipLevelCount = ImageHelpers::CalculateMipLevelCount(extent);
+    const Ktx2File::Description& description = file.GetDescription();
+    const std::vector<ByteView>& mipLevelsData = file.GetMipLevels();
 
-    const vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eStorage
-            | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst;
+    const bool generateMipLevels = mipLevelsData.size() == 1
+            && !ImageHelpers::IsCompressedFormat(description.format);
+
+    const uint32_t mipLevelCount = generateMipLevels
+            ? ImageHelpers::CalculateMipLevelCount(description.extent) : description.mipLevelCount;
+
+    vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
+
+    if (generateMipLevels)
+    {
+        usage |= vk::ImageUsageFlagBits::eTransferSrc;
+    }
 
     const ImageDescription imageDescription{
-        ImageType::e2D, format, extent3D,
-        mipLevelCount, 1, vk::SampleCountFlagBits::e1,
+        description.type, description.format, description.extent,
+        mipLevelCount, description.layerCount, vk::SampleCountFlagBits::e1,
         vk::ImageTiling::eOptimal, usage,
         vk::MemoryPropertyFlagBits::eDeviceLocal
     };
 
-    const vk::Image image = VulkanContext::imageManager->CreateImage(imageDescription,
-            ImageCreateFlagBits::eStagingBuffer);
-
-    const vk::ImageSubresourceRange fullImage(vk::ImageAspectFlagBits::eColor,
-            0, imageDescription.mipLevelCount, 0, imageDescription.layerCount);
-
-    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
-        {
-            Details::UpdateImage(commandBuffer, image, imageDescription, data);
+    return Details::CreateTextureWithData(imageDescription, Details::GetImageViewType(description), mipLevelsData);
+}
 
-            if (imageDescription.mipLevelCount > 1)
-            {
-                const vk::ImageSubresourceRange baseMipLevel(vk::ImageAspectFlagBits::eColor,
-                        0, 1, 0, imageDescription.layerCount);
+Texture TextureManager::CreateTexture(vk::Format format, const vk::Extent2D& extent, const ByteView& data) const
+{
+    const vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eStorage
+            | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst;
 
-                const ImageLayoutTransition layoutTransition{
-                    vk::ImageLayout::eTransferDstOptimal,
-                    vk::ImageLayout::eTransferSrcOptimal,
-                    PipelineBarrier{
-                        SyncScope::kTransferWrite,
-                        SyncScope::kTransferRead
-                    }
-                };
+    const ImageDescription imageDescription{
+        ImageType::e2D, format, VulkanHelpers::GetExtent3D(extent),
+        ImageHelpers::CalculateMipLevelCount(extent), 1, vk::SampleCountFlagBits::e1,
+        vk::ImageTiling::eOptimal, usage,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
 
-                ImageHelpers::TransitImageLayout(commandBuffer, image, baseMipLevel, layoutTransition);
+    return Details::CreateTextureWithData(imageDescription, vk::ImageViewType::e2D, { data });
+}
 
-                ImageHelpers::GenerateMipLevels(commandBuffer, image, extent3D, fullImage);
+Texture TextureManager::CreateTexture(vk::Format format, const vk::Extent2D& extent,
+        const std::vector<ByteView>& mipLevelsData) const
+{
+    const uint32_t mipLevelCount = static_cast<uint32_t>(mipLevelsData.size());
 
-                Details::TransitImageLayoutAfterMipLevelsGenerating(commandBuffer, image, fullImage);
-            }
-            else
-            {
-                const ImageLayoutTransition layoutTransition{
-                    vk::ImageLayout::eTransferDstOptimal,
-                    vk::ImageLayout::eShaderReadOnlyOptimal,
-                    PipelineBarrier{
-                        SyncScope::kTransferWrite,
-                        SyncScope::kBlockNone
-                    }
-                };
+    Assert(mipLevelCount > 0 && mipLevelCount <= ImageHelpers::CalculateMipLevelCount(extent));
 
-                ImageHelpers::TransitImageLayout(commandBuffer, image, fullImage, layoutTransition);
-            }
-        });
+    const vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
 
-    const vk::ImageView view = VulkanContext::imageManager->CreateView(image, vk::ImageViewType::e2D, fullImage);
+    const ImageDescription imageDescription{
+        ImageType::e2D, format, VulkanHelpers::GetExtent3D(extent),
+        mipLevelCount, 1, vk::SampleCountFlagBits::e1,
+        vk::ImageTiling::eOptimal, usage,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
 
-    return Texture{ image, view };
+    return Details::CreateTextureWithData(imageDescription, vk::ImageViewType::e2D, mipLevelsData);
 }
 
 Texture TextureManager::CreateCubeTexture(const Texture& panoramaTexture, const vk::Extent2D& extent) const
@@ -6,6 +6,7 @@
 #include "Utils/DataHelpers.hpp"
 
 class ComputePipeline;
+class Ktx2File;
 
 class TextureManager
 {
@@ -15,8 +16,13 @@ public:
 
     Texture CreateTexture(const Filepath& filepath) const;
 
+    Texture CreateTexture(const Ktx2File& file) const;
+
     Texture CreateTexture(vk::Format format, const vk::Extent2D& extent, const ByteView& data) const;
 
+    Texture CreateTexture(vk::Format format, const vk::Extent2D& extent,
+            const std::vector<ByteView>& mipLevelsData) const;
+
     Texture CreateCubeTexture(const Texture& panoramaTexture, const vk::Extent2D& extent) const;
 
     Texture CreateColorTexture(const glm::vec4& color) const;
@@ -19,10 +19,14 @@ namespace VulkanConfig
         VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME,
         VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
         VK_KHR_RAY_QUERY_EXTENSION_NAME,
+        VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
     };
 
     constexpr Device::Features kRequiredDeviceFeatures{
         .samplerAnisotropy = true,
+        .multiDrawIndirect = true,
+        .drawIndirectFirstInstance = true,
+        .textureCompressionBC = true,
         .accelerationStructure = true,
         .rayTracingPipeline = true,
         .descriptorIndexing = true,
@@ -34,6 +38,7 @@ namespace VulkanConfig
         { vk::DescriptorType::eUniformBuffer, 2048 },
         { vk::DescriptorType::eCombinedImageSampler, 2048 },
         { vk::DescriptorType::eStorageImage, 2048 },
+        { vk::DescriptorType::eStorageBuffer, 2048 },
         { vk::DescriptorType::eAccelerationStructureKHR, 512 }
     };
 
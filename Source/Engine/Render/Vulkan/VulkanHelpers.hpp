@@ -11,9 +11,12 @@ struct SyncScope
     static const SyncScope kBlockAll;
     static const SyncScope kTransferWrite;
     static const SyncScope kTransferRead;
+    static const SyncScope kHostRead;
     static const SyncScope kVerticesRead;
     static const SyncScope kIndicesRead;
+    static const SyncScope kIndirectCommandRead;
     static const SyncScope kAccelerationStructureBuild;
+    static const SyncScope kAccelerationStructureWrite;
     static const SyncScope kRayTracingShaderWrite;
     static const SyncScope kRayTracingShaderRead;
     static const SyncScope kRayTracingUniformRead;
@@ -3,6 +3,8 @@
 #include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
 #include "Shaders/Common/Common.h"
 
+class Ktx2File;
+
 class DirectLighting
 {
 public:
@@ -11,6 +13,8 @@ public:
 
     DirectLight RetrieveDirectLight(const Texture& panoramaTexture);
 
+    DirectLight RetrieveDirectLight(const Ktx2File& cubeFile) const;
+
 private:
     vk::DescriptorSetLayout storageImageLayout;
     vk::DescriptorSetLayout locationLayout;
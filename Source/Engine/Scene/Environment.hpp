@@ -19,10 +19,14 @@ public:
 
     const Texture& GetReflectionTexture() const { return iblTextures.reflection; }
 
+    vk::Buffer GetAliasTableBuffer() const { return aliasTableBuffer; }
+
 private:
     Texture texture;
 
     DirectLight directLight;
 
     ImageBasedLighting::Textures iblTextures;
+
+    vk::Buffer aliasTableBuffer;
 };
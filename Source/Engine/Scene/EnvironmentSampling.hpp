@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
+
+class EnvironmentSampling
+{
+public:
+    EnvironmentSampling();
+    ~EnvironmentSampling();
+
+    vk::Buffer GenerateAliasTable(const Texture& environmentTexture) const;
+
+private:
+    vk::DescriptorSetLayout luminanceLayout;
+
+    std::unique_ptr<ComputePipeline> luminancePipeline;
+};
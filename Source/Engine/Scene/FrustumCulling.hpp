@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Engine/Scene/Scene.hpp"
+
+class FrustumCulling
+{
+public:
+    using FrustumPlanes = std::array<glm::vec4, 6>;
+
+    struct VisibleRange
+    {
+        uint32_t firstObject;
+        uint32_t objectCount;
+    };
+
+    struct Stats
+    {
+        uint32_t objectCount = 0;
+        uint32_t visibleObjectCount = 0;
+        uint32_t batchCount = 0;
+        uint32_t visibleBatchCount = 0;
+        float cullingTime = 0.0f; // ms
+    };
+
+    FrustumCulling(const Scene& scene_);
+
+    void Cull(const FrustumPlanes& frustumPlanes);
+
+    const std::vector<uint32_t>& GetVisibleObjects() const { return visibleObjects; }
+
+    const std::vector<VisibleRange>& GetVisibleRanges() const { return visibleRanges; }
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    struct Bounds
+    {
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+        std::vector<float> extentX;
+        std::vector<float> extentY;
+        std::vector<float> extentZ;
+    };
+
+    const Scene& scene;
+
+    Bounds bounds;
+
+    std::vector<uint32_t> visibilityMasks;
+
+    std::vector<uint32_t> visibleObjects;
+    std::vector<VisibleRange> visibleRanges;
+
+    Stats stats;
+};
@@ -1,14 +1,97 @@
 #pragma once
 
+#include "Utils/DataHelpers.hpp"
+
 struct Mesh
 {
     std::vector<glm::vec3> vertices;
     std::vector<uint32_t> indices;
 };
 
+struct Meshlet
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    glm::vec3 center;
+    float radius;
+    glm::vec3 coneAxis;
+    float coneCutoff;
+};
+
+struct MeshLod
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    uint32_t firstMeshlet;
+    uint32_t meshletCount;
+    float error;
+};
+
+struct VertexCacheStatistics
+{
+    size_t transformedVertexCount = 0;
+    size_t triangleCount = 0;
+    size_t vertexCount = 0;
+
+    float GetACMR() const;
+
+    float GetATVR() const;
+
+    VertexCacheStatistics& operator+=(const VertexCacheStatistics& other);
+};
+
 namespace MeshHelpers
 {
     Mesh GenerateSphere(float radius, uint32_t sectorCount, uint32_t stackCount);
 
     Mesh GenerateSphere(float radius);
+
+    std::vector<glm::vec3> CalculateNormals(const DataView<uint32_t>& indices,
+            const DataView<glm::vec3>& positions, uint32_t threadCount);
+
+    std::vector<glm::vec3> CalculateTangents(const DataView<uint32_t>& indices,
+            const DataView<glm::vec3>& positions, const DataView<glm::vec2>& texCoords, uint32_t threadCount);
+
+    std::vector<uint32_t> OptimizeVertexCache(const DataView<uint32_t>& indices, size_t vertexCount);
+
+    std::vector<uint32_t> OptimizeOverdraw(const DataView<uint32_t>& indices, const DataView<glm::vec3>& positions);
+
+    std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    std::vector<uint32_t> SimplifyMesh(const DataView<uint32_t>& indices, const DataView<glm::vec3>& positions,
+            size_t targetIndexCount, float targetError, float& resultError);
+
+    std::vector<Meshlet> GenerateMeshlets(const DataView<uint32_t>& indices,
+            const DataView<glm::vec3>& positions, size_t maxVertexCount, size_t maxTriangleCount);
+
+    VertexCacheStatistics AnalyzeVertexCache(const DataView<uint32_t>& indices, size_t vertexCount);
+
+    glm::vec2 EncodeOctahedral(const glm::vec3& direction);
+
+    template <class T>
+    std::vector<T> RemapVertices(const std::vector<T>& vertices, const std::vector<uint32_t>& remap);
+}
+
+template <class T>
+std::vector<T> MeshHelpers::RemapVertices(const std::vector<T>& vertices, const std::vector<uint32_t>& remap)
+{
+    size_t vertexCount = 0;
+    for (const auto& index : remap)
+    {
+        if (index != std::numeric_limits<uint32_t>::max())
+        {
+            vertexCount = std::max(vertexCount, static_cast<size_t>(index) + 1);
+        }
+    }
+
+    std::vector<T> result(vertexCount);
+    for (size_t i = 0; i < remap.size(); ++i)
+    {
+        if (remap[i] != std::numeric_limits<uint32_t>::max())
+        {
+            result[remap[i]] = vertices[i];
+        }
+    }
+
+    return result;
 }
@@ -3,6 +3,7 @@
 #include "Engine/Render/Renderer.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Render/Vulkan/ComputePipeline.hpp"
+#include "Engine/Render/Vulkan/Resources/Ktx2File.hpp"
 
 namespace Details
 {
@@ -280,6 +281,52 @@ namespace Details
         return glm::dot(glm::vec3(color), glm::vec3(0.2126, 0.7152, 0.0722));
     }
 
+    static glm::vec4 ReadTexel(const ByteView& data, vk::Format format, size_t index)
+    {
+        switch (format)
+        {
+        case vk::Format::eR32G32B32A32Sfloat:
+            return reinterpret_cast<const glm::vec4*>(data.data)[index];
+        case vk::Format::eR16G16B16A16Sfloat:
+            return glm::unpackHalf4x16(reinterpret_cast<const uint64_t*>(data.data)[index]);
+        default:
+            Assert(false);
+            return glm::vec4();
+        }
+    }
+
+    static glm::vec3 GetCubeDirection(uint32_t face, const glm::vec2& uv)
+    {
+        const glm::vec2 st = uv * 2.0f - 1.0f;
+
+        switch (face)
+        {
+        case 0:
+            return glm::vec3(1.0f, -st.y, -st.x);
+        case 1:
+            return glm::vec3(-1.0f, -st.y, st.x);
+        case 2:
+            return glm::vec3(st.x, 1.0f, st.y);
+        case 3:
+            return glm::vec3(st.x, -1.0f, -st.y);
+        case 4:
+            return glm::vec3(st.x, -st.y, 1.0f);
+        case 5:
+            return glm::vec3(-st.x, -st.y, -1.0f);
+        default:
+            Assert(false);
+            return glm::vec3();
+        }
+    }
+
+    static DirectLight ClampDirectLight(DirectLight directLight)
+    {
+        const float luminance = GetLuminance(directLight.color);
+        directLight.color /= glm::max(luminance / kMaxLuminance, 1.0f);
+
+        return directLight;
+    }
+
     static DirectLight RetrieveDirectLight(vk::Buffer parametersBuffer)
     {
         const MemoryManager& memoryManager = *VulkanContext::memoryManager;
@@ -287,14 +334,11 @@ namespace Details
         const MemoryBlock memoryBlock = memoryManager.GetBufferMemoryBlock(parametersBuffer);
         const ByteAccess parameters = memoryManager.MapMemory(memoryBlock);
 
-        DirectLight directLight = *reinterpret_cast<DirectLight*>(parameters.data);
+        const DirectLight directLight = *reinterpret_cast<DirectLight*>(parameters.data);
 
         memoryManager.UnmapMemory(memoryBlock);
 
-        const float luminance = GetLuminance(directLight.color);
-        directLight.color /= glm::max(luminance / kMaxLuminance, 1.0f);
-
-        return directLight;
+        return ClampDirectLight(directLight);
     }
 }
 
@@ -457,3 +501,49 @@ DirectLight DirectLighting::RetrieveDirectLight(const Texture& panoramaTexture)
 
     return directLight;
 }
+
+DirectLight DirectLighting::RetrieveDirectLight(const Ktx2File& cubeFile) const
+{
+    const Ktx2File::Description& description = cubeFile.GetDescription();
+
+    Assert(description.type == ImageType::eCube);
+
+    const uint32_t blockMipLevel = static_cast<uint32_t>(std::log2(
+            std::max(Details::kLuminanceBlockSize.x, Details::kLuminanceBlockSize.y)));
+
+    const uint32_t mipLevel = std::min(blockMipLevel, description.mipLevelCount - 1);
+
+    const vk::Extent3D extent = ImageHelpers::CalculateMipLevelExtent(description.extent, mipLevel);
+    const ByteView& data = cubeFile.GetMipLevels()[mipLevel];
+
+    const size_t faceTexelCount = static_cast<size_t>(extent.width) * extent.height;
+
+    size_t brightestTexel = 0;
+    float maxLuminance = -1.0f;
+
+    for (size_t i = 0; i < faceTexelCount * ImageHelpers::kCubeFaceCount; ++i)
+    {
+        const float luminance = Details::GetLuminance(Details::ReadTexel(data, description.format, i));
+
+        if (luminance > maxLuminance)
+        {
+            brightestTexel = i;
+            maxLuminance = luminance;
+        }
+    }
+
+    const uint32_t face = static_cast<uint32_t>(brightestTexel / faceTexelCount);
+    const uint32_t faceTexel = static_cast<uint32_t>(brightestTexel % faceTexelCount);
+
+    const glm::vec2 uv = (glm::vec2(glm::uvec2(faceTexel % extent.width, faceTexel / extent.width)) + 0.5f)
+            / glm::vec2(glm::uvec2(extent.width, extent.height));
+
+    const glm::vec3 direction = Details::GetCubeDirection(face, uv);
+
+    const DirectLight directLight{
+        glm::vec4(glm::normalize(-direction), 0.0f),
+        Details::ReadTexel(data, description.format, brightestTexel)
+    };
+
+    return Details::ClampDirectLight(directLight);
+}
@@ -3,8 +3,11 @@
 #include "Engine/Render/Renderer.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Render/Vulkan/ComputePipeline.hpp"
+#include "Engine/Render/Vulkan/Resources/Ktx2File.hpp"
 #include "Engine/Scene/DirectLighting.hpp"
+#include "Engine/Scene/EnvironmentSampling.hpp"
 #include "Engine/Scene/ImageBasedLighting.hpp"
+#include "Engine/Config.hpp"
 
 namespace Details
 {
@@ -33,15 +36,47 @@ namespace Details
 
         return VulkanContext::textureManager->CreateCubeTexture(panoramaTexture, environmentExtent);
     }
+
+    static vk::Buffer CreateAliasTableBuffer(const Texture& environmentTexture)
+    {
+        if constexpr (Config::kEnvironmentSampling)
+        {
+            return Renderer::environmentSampling->GenerateAliasTable(environmentTexture);
+        }
+        else
+        {
+            return vk::Buffer();
+        }
+    }
 }
 
 Environment::Environment(const Filepath& path)
 {
-    const Texture panoramaTexture = VulkanContext::textureManager->CreateTexture(path);
+    std::unique_ptr<Ktx2File> file;
+
+    if (path.GetExtension() == ".ktx2")
+    {
+        file = std::make_unique<Ktx2File>(path);
+
+        if (file->GetDescription().type == ImageType::eCube)
+        {
+            texture = VulkanContext::textureManager->CreateTexture(*file);
+            directLight = Renderer::directLighting->RetrieveDirectLight(*file);
+            iblTextures = Renderer::imageBasedLighting->GenerateTextures(texture);
+            aliasTableBuffer = Details::CreateAliasTableBuffer(texture);
+
+            return;
+        }
+    }
+
+    const Texture panoramaTexture = file
+            ? VulkanContext::textureManager->CreateTexture(*file)
+            : VulkanContext::textureManager->CreateTexture(path);
 
     texture = Details::CreateEnvironmentTexture(panoramaTexture);
     directLight = Renderer::directLighting->RetrieveDirectLight(panoramaTexture);
     iblTextures = Renderer::imageBasedLighting->GenerateTextures(texture);
+    aliasTableBuffer = Details::CreateAliasTableBuffer(texture);
 
     VulkanContext::textureManager->DestroyTexture(panoramaTexture);
 }
@@ -51,4 +86,9 @@ Environment::~Environment()
     VulkanContext::textureManager->DestroyTexture(texture);
     VulkanContext::textureManager->DestroyTexture(iblTextures.irradiance);
     VulkanContext::textureManager->DestroyTexture(iblTextures.reflection);
+
+    if (aliasTableBuffer)
+    {
+        VulkanContext::bufferManager->DestroyBuffer(aliasTableBuffer);
+    }
 }
@@ -0,0 +1,251 @@
+#include <numeric>
+
+#include "Engine/Scene/EnvironmentSampling.hpp"
+
+#include "Engine/Render/Renderer.hpp"
+#include "Engine/Render/Vulkan/ComputeHelpers.hpp"
+#include "Engine/Render/Vulkan/ComputePipeline.hpp"
+#include "Engine/Render/Vulkan/DescriptorHelpers.hpp"
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Shaders/PathTracing/PathTracing.h"
+
+#include "Utils/Helpers.hpp"
+#include "Utils/TimeHelpers.hpp"
+
+namespace Details
+{
+    struct LuminanceData
+    {
+        vk::Buffer buffer;
+        vk::DescriptorSet descriptorSet;
+    };
+
+    static constexpr glm::uvec2 kWorkGroupSize(8, 8);
+
+    static constexpr vk::Extent2D kLuminanceExtent(ENVIRONMENT_SAMPLING_WIDTH, ENVIRONMENT_SAMPLING_HEIGHT);
+
+    static const Filepath kLuminanceShaderPath("~/Shaders/Compute/EnvironmentSampling/Luminance.comp");
+
+    static vk::DescriptorSetLayout CreateLuminanceLayout()
+    {
+        const DescriptorDescription environmentDescriptorDescription{
+            1, vk::DescriptorType::eCombinedImageSampler,
+            vk::ShaderStageFlagBits::eCompute,
+            vk::DescriptorBindingFlags()
+        };
+
+        const DescriptorDescription luminanceDescriptorDescription{
+            1, vk::DescriptorType::eStorageBuffer,
+            vk::ShaderStageFlagBits::eCompute,
+            vk::DescriptorBindingFlags()
+        };
+
+        return VulkanContext::descriptorPool->CreateDescriptorSetLayout({
+            environmentDescriptorDescription, luminanceDescriptorDescription
+        });
+    }
+
+    static std::unique_ptr<ComputePipeline> CreateLuminancePipeline(vk::DescriptorSetLayout layout)
+    {
+        const std::tuple specializationValues = std::make_tuple(kWorkGroupSize.x, kWorkGroupSize.y, 1);
+
+        const ShaderModule shaderModule = VulkanContext::shaderManager->CreateShaderModule(
+                vk::ShaderStageFlagBits::eCompute, kLuminanceShaderPath, {}, specializationValues);
+
+        const ComputePipeline::Description pipelineDescription{
+            shaderModule, { layout }, {}
+        };
+
+        std::unique_ptr<ComputePipeline> pipeline = ComputePipeline::Create(pipelineDescription);
+
+        VulkanContext::shaderManager->DestroyShaderModule(shaderModule);
+
+        return pipeline;
+    }
+
+    static LuminanceData CreateLuminanceData(vk::DescriptorSetLayout layout, const Texture& environmentTexture)
+    {
+        const vk::MemoryPropertyFlags memoryProperties
+                = vk::MemoryPropertyFlagBits::eHostVisible
+                | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+        const BufferDescription bufferDescription{
+            sizeof(float) * kLuminanceExtent.width * kLuminanceExtent.height,
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            memoryProperties
+        };
+
+        const vk::Buffer buffer = VulkanContext::bufferManager->CreateBuffer(
+                bufferDescription, BufferCreateFlags::kNone);
+
+        const DescriptorPool& descriptorPool = *VulkanContext::descriptorPool;
+
+        const BufferInfo bufferInfo{ vk::DescriptorBufferInfo(buffer, 0, VK_WHOLE_SIZE) };
+
+        const DescriptorSetData descriptorSetData{
+            DescriptorHelpers::GetData(Renderer::defaultSampler, environmentTexture.view),
+            DescriptorData{ vk::DescriptorType::eStorageBuffer, bufferInfo }
+        };
+
+        const vk::DescriptorSet descriptorSet = descriptorPool.AllocateDescriptorSets({ layout }).front();
+
+        descriptorPool.UpdateDescriptorSet(descriptorSet, descriptorSetData, 0);
+
+        return LuminanceData{ buffer, descriptorSet };
+    }
+
+    static std::vector<float> RetrieveLuminance(vk::Buffer luminanceBuffer)
+    {
+        const MemoryManager& memoryManager = *VulkanContext::memoryManager;
+
+        const MemoryBlock memoryBlock = memoryManager.GetBufferMemoryBlock(luminanceBuffer);
+        const ByteAccess data = memoryManager.MapMemory(memoryBlock);
+
+        const float* luminance = reinterpret_cast<const float*>(data.data);
+
+        std::vector<float> result(luminance, luminance + kLuminanceExtent.width * kLuminanceExtent.height);
+
+        memoryManager.UnmapMemory(memoryBlock);
+
+        return result;
+    }
+
+    // Vose's alias method over texel luminance weighted by the solid angle of the texel
+    static std::vector<EnvironmentAliasEntry> CreateAliasTable(const std::vector<float>& luminance)
+    {
+        const size_t texelCount = luminance.size();
+
+        std::vector<float> weights(texelCount);
+
+        for (uint32_t y = 0; y < kLuminanceExtent.height; ++y)
+        {
+            const float theta = Numbers::kPi * (static_cast<float>(y) + 0.5f)
+                    / static_cast<float>(kLuminanceExtent.height);
+
+            const float sinTheta = std::sin(theta);
+
+            for (uint32_t x = 0; x < kLuminanceExtent.width; ++x)
+            {
+                const size_t index = static_cast<size_t>(y) * kLuminanceExtent.width + x;
+
+                weights[index] = std::max(luminance[index], 0.0f) * sinTheta;
+            }
+        }
+
+        const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+
+        std::vector<EnvironmentAliasEntry> aliasTable(texelCount);
+
+        if (weightSum <= 0.0)
+        {
+            for (size_t i = 0; i < texelCount; ++i)
+            {
+                aliasTable[i] = EnvironmentAliasEntry{ 1.0f, static_cast<uint32_t>(i), 1.0f };
+            }
+
+            return aliasTable;
+        }
+
+        std::vector<float> probabilities(texelCount);
+
+        std::vector<uint32_t> small;
+        std::vector<uint32_t> large;
+
+        for (size_t i = 0; i < texelCount; ++i)
+        {
+            probabilities[i] = static_cast<float>(weights[i] / weightSum * static_cast<double>(texelCount));
+
+            aliasTable[i].pdf = probabilities[i];
+
+            if (probabilities[i] < 1.0f)
+            {
+                small.push_back(static_cast<uint32_t>(i));
+            }
+            else
+            {
+                large.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        while (!small.empty() && !large.empty())
+        {
+            const uint32_t smallIndex = small.back();
+            const uint32_t largeIndex = large.back();
+
+            small.pop_back();
+            large.pop_back();
+
+            aliasTable[smallIndex].probability = probabilities[smallIndex];
+            aliasTable[smallIndex].alias = largeIndex;
+
+            probabilities[largeIndex] -= 1.0f - probabilities[smallIndex];
+
+            if (probabilities[largeIndex] < 1.0f)
+            {
+                small.push_back(largeIndex);
+            }
+            else
+            {
+                large.push_back(largeIndex);
+            }
+        }
+
+        // Remaining entries are equal to 1 up to the rounding errors
+        for (const uint32_t index : small)
+        {
+            aliasTable[index].probability = 1.0f;
+            aliasTable[index].alias = index;
+        }
+
+        for (const uint32_t index : large)
+        {
+            aliasTable[index].probability = 1.0f;
+            aliasTable[index].alias = index;
+        }
+
+        return aliasTable;
+    }
+}
+
+EnvironmentSampling::EnvironmentSampling()
+{
+    luminanceLayout = Details::CreateLuminanceLayout();
+
+    luminancePipeline = Details::CreateLuminancePipeline(luminanceLayout);
+}
+
+EnvironmentSampling::~EnvironmentSampling()
+{
+    VulkanContext::descriptorPool->DestroyDescriptorSetLayout(luminanceLayout);
+}
+
+vk::Buffer EnvironmentSampling::GenerateAliasTable(const Texture& environmentTexture) const
+{
+    ScopeTime scopeTime("EnvironmentSampling::GenerateAliasTable");
+
+    const Details::LuminanceData luminanceData = Details::CreateLuminanceData(luminanceLayout, environmentTexture);
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, luminancePipeline->Get());
+
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                    luminancePipeline->GetLayout(), 0, { luminanceData.descriptorSet }, {});
+
+            const glm::uvec3 groupCount = ComputeHelpers::CalculateWorkGroupCount(
+                    Details::kLuminanceExtent, Details::kWorkGroupSize);
+
+            commandBuffer.dispatch(groupCount.x, groupCount.y, groupCount.z);
+
+            BufferHelpers::InsertPipelineBarrier(commandBuffer, luminanceData.buffer,
+                    PipelineBarrier{ SyncScope::kComputeShaderWrite, SyncScope::kHostRead });
+        });
+
+    const std::vector<EnvironmentAliasEntry> aliasTable
+            = Details::CreateAliasTable(Details::RetrieveLuminance(luminanceData.buffer));
+
+    VulkanContext::descriptorPool->FreeDescriptorSets({ luminanceData.descriptorSet });
+    VulkanContext::bufferManager->DestroyBuffer(luminanceData.buffer);
+
+    return BufferHelpers::CreateBufferWithData(vk::BufferUsageFlagBits::eStorageBuffer, ByteView(aliasTable));
+}
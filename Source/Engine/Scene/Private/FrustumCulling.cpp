@@ -0,0 +1,144 @@
+#include "Engine/Scene/FrustumCulling.hpp"
+
+#include "Utils/SimdHelpers.hpp"
+#include "Utils/TimeHelpers.hpp"
+
+namespace Details
+{
+    static size_t GetPaddedCount(size_t count)
+    {
+        return (count + SimdHelpers::kWidth - 1) / SimdHelpers::kWidth * SimdHelpers::kWidth;
+    }
+
+    static uint32_t TestBounds(const float* centerX, const float* centerY, const float* centerZ,
+            const float* extentX, const float* extentY, const float* extentZ,
+            const FrustumCulling::FrustumPlanes& frustumPlanes)
+    {
+        const SimdHelpers::Float cx = SimdHelpers::Load(centerX);
+        const SimdHelpers::Float cy = SimdHelpers::Load(centerY);
+        const SimdHelpers::Float cz = SimdHelpers::Load(centerZ);
+        const SimdHelpers::Float ex = SimdHelpers::Load(extentX);
+        const SimdHelpers::Float ey = SimdHelpers::Load(extentY);
+        const SimdHelpers::Float ez = SimdHelpers::Load(extentZ);
+
+        const SimdHelpers::Float zero = SimdHelpers::Set(0.0f);
+
+        SimdHelpers::Float visible = SimdHelpers::Equal(zero, zero);
+
+        for (const glm::vec4& plane : frustumPlanes)
+        {
+            const glm::vec3 absNormal = glm::abs(glm::vec3(plane));
+
+            const SimdHelpers::Float distance = SimdHelpers::Add(SimdHelpers::Add(
+                    SimdHelpers::Mul(cx, SimdHelpers::Set(plane.x)),
+                    SimdHelpers::Mul(cy, SimdHelpers::Set(plane.y))), SimdHelpers::Add(
+                    SimdHelpers::Mul(cz, SimdHelpers::Set(plane.z)),
+                    SimdHelpers::Set(plane.w)));
+
+            const SimdHelpers::Float radius = SimdHelpers::Add(SimdHelpers::Add(
+                    SimdHelpers::Mul(ex, SimdHelpers::Set(absNormal.x)),
+                    SimdHelpers::Mul(ey, SimdHelpers::Set(absNormal.y))),
+                    SimdHelpers::Mul(ez, SimdHelpers::Set(absNormal.z)));
+
+            const SimdHelpers::Float inside = SimdHelpers::Greater(SimdHelpers::Add(distance, radius), zero);
+
+            visible = SimdHelpers::And(visible, inside);
+        }
+
+        return SimdHelpers::MoveMask(visible);
+    }
+}
+
+FrustumCulling::FrustumCulling(const Scene& scene_)
+    : scene(scene_)
+{
+    const Scene::Hierarchy& hierarchy = scene.GetHierarchy();
+    const Scene::RenderQueue& renderQueue = scene.GetRenderQueue();
+
+    const size_t objectCount = renderQueue.objectIndices.size();
+    const size_t paddedCount = Details::GetPaddedCount(objectCount);
+
+    for (std::vector<float>* values : { &bounds.centerX, &bounds.centerY, &bounds.centerZ,
+            &bounds.extentX, &bounds.extentY, &bounds.extentZ })
+    {
+        values->resize(paddedCount, 0.0f);
+    }
+
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        const Scene::RenderObject& renderObject = hierarchy.renderObjects[renderQueue.objectIndices[i]];
+        const Scene::Mesh& mesh = hierarchy.meshes[renderObject.meshIndex];
+
+        const glm::vec3 localExtent = mesh.positionScale * 0.5f;
+        const glm::vec3 localCenter = mesh.positionOffset + localExtent;
+
+        const glm::vec3 center = glm::vec3(renderObject.transform * glm::vec4(localCenter, 1.0f));
+
+        const glm::mat3 absTransform(
+                glm::abs(glm::vec3(renderObject.transform[0])),
+                glm::abs(glm::vec3(renderObject.transform[1])),
+                glm::abs(glm::vec3(renderObject.transform[2])));
+
+        const glm::vec3 extent = absTransform * localExtent;
+
+        bounds.centerX[i] = center.x;
+        bounds.centerY[i] = center.y;
+        bounds.centerZ[i] = center.z;
+        bounds.extentX[i] = extent.x;
+        bounds.extentY[i] = extent.y;
+        bounds.extentZ[i] = extent.z;
+    }
+
+    visibilityMasks.resize(paddedCount / SimdHelpers::kWidth);
+
+    visibleObjects.reserve(objectCount);
+    visibleRanges.resize(renderQueue.batches.size());
+
+    stats.objectCount = static_cast<uint32_t>(objectCount);
+    stats.batchCount = static_cast<uint32_t>(renderQueue.batches.size());
+}
+
+void FrustumCulling::Cull(const FrustumPlanes& frustumPlanes)
+{
+    const TimePoint start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < visibilityMasks.size(); ++i)
+    {
+        const size_t offset = i * SimdHelpers::kWidth;
+
+        visibilityMasks[i] = Details::TestBounds(
+                bounds.centerX.data() + offset, bounds.centerY.data() + offset, bounds.centerZ.data() + offset,
+                bounds.extentX.data() + offset, bounds.extentY.data() + offset, bounds.extentZ.data() + offset,
+                frustumPlanes);
+    }
+
+    const std::vector<Scene::RenderBatch>& batches = scene.GetRenderQueue().batches;
+
+    visibleObjects.clear();
+
+    stats.visibleBatchCount = 0;
+
+    for (size_t i = 0; i < batches.size(); ++i)
+    {
+        const uint32_t firstVisibleObject = static_cast<uint32_t>(visibleObjects.size());
+
+        for (uint32_t j = batches[i].firstObject; j < batches[i].firstObject + batches[i].objectCount; ++j)
+        {
+            if (visibilityMasks[j / SimdHelpers::kWidth] >> (j % SimdHelpers::kWidth) & 1)
+            {
+                visibleObjects.push_back(j);
+            }
+        }
+
+        visibleRanges[i] = VisibleRange{
+            firstVisibleObject,
+            static_cast<uint32_t>(visibleObjects.size()) - firstVisibleObject
+        };
+
+        stats.visibleBatchCount += visibleRanges[i].objectCount > 0 ? 1 : 0;
+    }
+
+    stats.visibleObjectCount = static_cast<uint32_t>(visibleObjects.size());
+    stats.cullingTime = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+}
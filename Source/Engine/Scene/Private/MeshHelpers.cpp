@@ -1,11 +1,560 @@
+#include <unordered_map>
+
 #include "Engine/Scene/MeshHelpers.hpp"
 
+#include "Engine/EngineHelpers.hpp"
+
+#include "Utils/Assert.hpp"
 #include "Utils/Helpers.hpp"
+#include "Utils/SimdHelpers.hpp"
+#include "Utils/ThreadHelpers.hpp"
 
 namespace Details
 {
     static constexpr uint32_t kDefaultSectorCount = 256;
     static constexpr uint32_t kDefaultStackCount = 128;
+
+    static constexpr size_t kChunkSize = 4096;
+
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    static constexpr size_t kOptimizationCacheSize = 32;
+    static constexpr size_t kAnalysisCacheSize = 16;
+
+    static constexpr float kCacheDecayPower = 1.5f;
+    static constexpr float kLastTriangleScore = 0.75f;
+    static constexpr float kValenceBoostScale = 2.0f;
+    static constexpr float kValenceBoostPower = 0.5f;
+
+    static constexpr float kMinMeshletConeDot = 0.1f;
+
+    static constexpr float kMaxCollapseNormalDot = 0.0f;
+
+    struct Vec3Lanes
+    {
+        SimdHelpers::Float x;
+        SimdHelpers::Float y;
+        SimdHelpers::Float z;
+    };
+
+    using FaceIndices = std::array<uint32_t, SimdHelpers::kWidth * 3>;
+
+    using RangeFunctor = std::function<void(size_t, size_t)>;
+
+    static void ForEachRange(size_t count, size_t rangeSize, uint32_t threadCount, const RangeFunctor& functor)
+    {
+        const size_t rangeCount = (count + rangeSize - 1) / rangeSize;
+
+        ThreadHelpers::ParallelFor(rangeCount, threadCount, [&](size_t i)
+            {
+                functor(i * rangeSize, std::min((i + 1) * rangeSize, count));
+            });
+    }
+
+    static const uint32_t* GetFaceIndices(const DataView<uint32_t>& indices,
+            size_t face, size_t count, FaceIndices& paddedIndices)
+    {
+        if (count == SimdHelpers::kWidth)
+        {
+            return indices.data + face * 3;
+        }
+
+        paddedIndices.fill(0);
+
+        std::copy(indices.data + face * 3, indices.data + (face + count) * 3, paddedIndices.begin());
+
+        return paddedIndices.data();
+    }
+
+    static Vec3Lanes GatherVectors(const glm::vec3* data, const uint32_t* indices)
+    {
+        const float* values = reinterpret_cast<const float*>(data);
+
+        return Vec3Lanes{
+            SimdHelpers::Gather(values, 3, indices, 3),
+            SimdHelpers::Gather(values + 1, 3, indices, 3),
+            SimdHelpers::Gather(values + 2, 3, indices, 3)
+        };
+    }
+
+    static Vec3Lanes SubtractVectors(const Vec3Lanes& a, const Vec3Lanes& b)
+    {
+        return Vec3Lanes{
+            SimdHelpers::Sub(a.x, b.x),
+            SimdHelpers::Sub(a.y, b.y),
+            SimdHelpers::Sub(a.z, b.z)
+        };
+    }
+
+    static Vec3Lanes LoadVectors(const glm::vec3* data, size_t count)
+    {
+        std::array<glm::vec3, SimdHelpers::kWidth> paddedData;
+
+        if (count < SimdHelpers::kWidth)
+        {
+            paddedData.fill(glm::vec3(0.0f));
+
+            std::copy(data, data + count, paddedData.begin());
+
+            data = paddedData.data();
+        }
+
+        const float* values = reinterpret_cast<const float*>(data);
+
+        return Vec3Lanes{
+            SimdHelpers::LoadStrided(values, 3),
+            SimdHelpers::LoadStrided(values + 1, 3),
+            SimdHelpers::LoadStrided(values + 2, 3)
+        };
+    }
+
+    static void StoreVectors(glm::vec3* data, size_t count, const Vec3Lanes& lanes)
+    {
+        std::array<glm::vec3, SimdHelpers::kWidth> paddedData;
+
+        glm::vec3* target = count < SimdHelpers::kWidth ? paddedData.data() : data;
+
+        float* values = reinterpret_cast<float*>(target);
+
+        SimdHelpers::StoreStrided(values, 3, lanes.x);
+        SimdHelpers::StoreStrided(values + 1, 3, lanes.y);
+        SimdHelpers::StoreStrided(values + 2, 3, lanes.z);
+
+        if (target != data)
+        {
+            std::copy(paddedData.begin(), paddedData.begin() + count, data);
+        }
+    }
+
+    static Vec3Lanes NormalizeVectors(const Vec3Lanes& lanes, const glm::vec3& fallback)
+    {
+        using namespace SimdHelpers;
+
+        const Float lengthSquared = Add(Add(Mul(lanes.x, lanes.x), Mul(lanes.y, lanes.y)), Mul(lanes.z, lanes.z));
+        const Float inverseLength = Div(Set(1.0f), Sqrt(lengthSquared));
+        const Float mask = Greater(lengthSquared, Set(0.0f));
+
+        return Vec3Lanes{
+            Select(mask, Mul(lanes.x, inverseLength), Set(fallback.x)),
+            Select(mask, Mul(lanes.y, inverseLength), Set(fallback.y)),
+            Select(mask, Mul(lanes.z, inverseLength), Set(fallback.z))
+        };
+    }
+
+    static void CalculateFaceNormals(const DataView<uint32_t>& indices, const DataView<glm::vec3>& positions,
+            size_t begin, size_t end, std::vector<glm::vec3>& faceNormals)
+    {
+        using namespace SimdHelpers;
+
+        FaceIndices paddedIndices;
+
+        for (size_t i = begin; i < end; i += kWidth)
+        {
+            const size_t count = std::min(kWidth, end - i);
+
+            const uint32_t* face = GetFaceIndices(indices, i, count, paddedIndices);
+
+            const Vec3Lanes position0 = GatherVectors(positions.data, face);
+            const Vec3Lanes edge1 = SubtractVectors(GatherVectors(positions.data, face + 1), position0);
+            const Vec3Lanes edge2 = SubtractVectors(GatherVectors(positions.data, face + 2), position0);
+
+            const Vec3Lanes normal{
+                Sub(Mul(edge1.y, edge2.z), Mul(edge2.y, edge1.z)),
+                Sub(Mul(edge1.z, edge2.x), Mul(edge2.z, edge1.x)),
+                Sub(Mul(edge1.x, edge2.y), Mul(edge2.x, edge1.y))
+            };
+
+            StoreVectors(faceNormals.data() + i, count, NormalizeVectors(normal, glm::vec3(0.0f)));
+        }
+    }
+
+    static void CalculateFaceTangents(const DataView<uint32_t>& indices, const DataView<glm::vec3>& positions,
+            const DataView<glm::vec2>& texCoords, size_t begin, size_t end, std::vector<glm::vec3>& faceTangents)
+    {
+        using namespace SimdHelpers;
+
+        const float* texCoordsData = reinterpret_cast<const float*>(texCoords.data);
+
+        FaceIndices paddedIndices;
+
+        for (size_t i = begin; i < end; i += kWidth)
+        {
+            const size_t count = std::min(kWidth, end - i);
+
+            const uint32_t* face = GetFaceIndices(indices, i, count, paddedIndices);
+
+            const Vec3Lanes position0 = GatherVectors(positions.data, face);
+            const Vec3Lanes edge1 = SubtractVectors(GatherVectors(positions.data, face + 1), position0);
+            const Vec3Lanes edge2 = SubtractVectors(GatherVectors(positions.data, face + 2), position0);
+
+            const Float texCoord0U = SimdHelpers::Gather(texCoordsData, 2, face, 3);
+            const Float texCoord0V = SimdHelpers::Gather(texCoordsData + 1, 2, face, 3);
+
+            const Float deltaTexCoord1U = Sub(SimdHelpers::Gather(texCoordsData, 2, face + 1, 3), texCoord0U);
+            const Float deltaTexCoord1V = Sub(SimdHelpers::Gather(texCoordsData + 1, 2, face + 1, 3), texCoord0V);
+            const Float deltaTexCoord2U = Sub(SimdHelpers::Gather(texCoordsData, 2, face + 2, 3), texCoord0U);
+            const Float deltaTexCoord2V = Sub(SimdHelpers::Gather(texCoordsData + 1, 2, face + 2, 3), texCoord0V);
+
+            Float d = Sub(Mul(deltaTexCoord1U, deltaTexCoord2V), Mul(deltaTexCoord1V, deltaTexCoord2U));
+
+            d = Select(Equal(d, Set(0.0f)), Set(1.0f), d);
+
+            const Vec3Lanes tangent{
+                Div(Sub(Mul(edge1.x, deltaTexCoord2V), Mul(edge2.x, deltaTexCoord1V)), d),
+                Div(Sub(Mul(edge1.y, deltaTexCoord2V), Mul(edge2.y, deltaTexCoord1V)), d),
+                Div(Sub(Mul(edge1.z, deltaTexCoord2V), Mul(edge2.z, deltaTexCoord1V)), d)
+            };
+
+            StoreVectors(faceTangents.data() + i, count, tangent);
+        }
+    }
+
+    static void NormalizeRange(std::vector<glm::vec3>& vectors, size_t begin, size_t end, const glm::vec3& fallback)
+    {
+        for (size_t i = begin; i < end; i += SimdHelpers::kWidth)
+        {
+            const size_t count = std::min(SimdHelpers::kWidth, end - i);
+
+            StoreVectors(vectors.data() + i, count, NormalizeVectors(LoadVectors(vectors.data() + i, count), fallback));
+        }
+    }
+
+    struct VertexTriangles
+    {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> counts;
+        std::vector<uint32_t> triangles;
+    };
+
+    static VertexTriangles GetVertexTriangles(const DataView<uint32_t>& indices, size_t vertexCount)
+    {
+        VertexTriangles vertexTriangles;
+        vertexTriangles.offsets.resize(vertexCount, 0);
+        vertexTriangles.counts.resize(vertexCount, 0);
+        vertexTriangles.triangles.resize(indices.size);
+
+        for (size_t i = 0; i < indices.size; ++i)
+        {
+            Assert(indices.data[i] < vertexCount);
+
+            ++vertexTriangles.counts[indices.data[i]];
+        }
+
+        uint32_t offset = 0;
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            vertexTriangles.offsets[i] = offset;
+            offset += vertexTriangles.counts[i];
+        }
+
+        std::vector<uint32_t> fillCounts(vertexCount, 0);
+        for (size_t i = 0; i < indices.size; ++i)
+        {
+            const uint32_t index = indices.data[i];
+
+            vertexTriangles.triangles[vertexTriangles.offsets[index] + fillCounts[index]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        return vertexTriangles;
+    }
+
+    static float CalculateVertexScore(int32_t cachePosition, uint32_t remainingTriangleCount)
+    {
+        if (remainingTriangleCount == 0)
+        {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                score = kLastTriangleScore;
+            }
+            else
+            {
+                const float scale = 1.0f / static_cast<float>(kOptimizationCacheSize - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, kCacheDecayPower);
+            }
+        }
+
+        score += kValenceBoostScale * std::pow(static_cast<float>(remainingTriangleCount), -kValenceBoostPower);
+
+        return score;
+    }
+
+    static glm::vec3 CalculateCentroid(const DataView<glm::vec3>& positions)
+    {
+        glm::vec3 centroid(0.0f);
+
+        for (size_t i = 0; i < positions.size; ++i)
+        {
+            centroid += positions.data[i];
+        }
+
+        return positions.size > 0 ? centroid / static_cast<float>(positions.size) : centroid;
+    }
+
+    static std::vector<glm::vec3> AccumulateFaceValues(const DataView<uint32_t>& indices, size_t vertexCount,
+            const std::vector<glm::vec3>& faceValues, const glm::vec3& fallback, uint32_t threadCount)
+    {
+        std::vector<glm::vec3> vertexValues(vertexCount, glm::vec3(0.0f));
+
+        // Faces are bucketed per vertex in index order, so sums match the serial order for any thread count
+        const VertexTriangles vertexTriangles = GetVertexTriangles(indices, vertexCount);
+
+        ForEachRange(vertexCount, kChunkSize, threadCount, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const uint32_t offset = vertexTriangles.offsets[i];
+
+                    for (uint32_t j = offset; j < offset + vertexTriangles.counts[i]; ++j)
+                    {
+                        vertexValues[i] += faceValues[vertexTriangles.triangles[j]];
+                    }
+                }
+
+                NormalizeRange(vertexValues, begin, end, fallback);
+            });
+
+        return vertexValues;
+    }
+
+    static void CalculateMeshletBounds(Meshlet& meshlet,
+            const DataView<uint32_t>& indices, const DataView<glm::vec3>& positions)
+    {
+        glm::vec3 minPosition(std::numeric_limits<float>::max());
+        glm::vec3 maxPosition(std::numeric_limits<float>::lowest());
+
+        for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; ++i)
+        {
+            minPosition = glm::min(minPosition, positions.data[indices.data[i]]);
+            maxPosition = glm::max(maxPosition, positions.data[indices.data[i]]);
+        }
+
+        meshlet.center = (minPosition + maxPosition) * 0.5f;
+        meshlet.radius = 0.0f;
+
+        std::vector<glm::vec3> normals;
+        normals.reserve(meshlet.indexCount / 3);
+
+        for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; i += 3)
+        {
+            const glm::vec3& a = positions.data[indices.data[i]];
+            const glm::vec3& b = positions.data[indices.data[i + 1]];
+            const glm::vec3& c = positions.data[indices.data[i + 2]];
+
+            meshlet.radius = std::max(meshlet.radius, glm::distance(meshlet.center, a));
+            meshlet.radius = std::max(meshlet.radius, glm::distance(meshlet.center, b));
+            meshlet.radius = std::max(meshlet.radius, glm::distance(meshlet.center, c));
+
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+            const float length = glm::length(normal);
+
+            if (length > 0.0f)
+            {
+                normals.push_back(normal / length);
+            }
+        }
+
+        glm::vec3 axis(0.0f);
+        for (const auto& normal : normals)
+        {
+            axis += normal;
+        }
+
+        const float axisLength = glm::length(axis);
+
+        meshlet.coneAxis = axisLength > 0.0f ? axis / axisLength : Direction::kUp;
+        meshlet.coneCutoff = 1.0f;
+
+        if (normals.empty() || axisLength == 0.0f)
+        {
+            return;
+        }
+
+        float minDot = 1.0f;
+        for (const auto& normal : normals)
+        {
+            minDot = std::min(minDot, glm::dot(meshlet.coneAxis, normal));
+        }
+
+        if (minDot > kMinMeshletConeDot)
+        {
+            meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+    }
+
+    struct Quadric
+    {
+        glm::mat4 matrix = glm::mat4(0.0f);
+        float weight = 0.0f;
+    };
+
+    struct EdgeCollapse
+    {
+        uint32_t source;
+        uint32_t target;
+        float cost;
+    };
+
+    static Quadric CalculatePlaneQuadric(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+    {
+        const glm::vec3 normal = glm::cross(b - a, c - a);
+        const float area = glm::length(normal);
+
+        if (area == 0.0f)
+        {
+            return Quadric{};
+        }
+
+        const glm::vec4 plane(normal / area, -glm::dot(normal / area, a));
+
+        return Quadric{ glm::outerProduct(plane, plane) * area, area };
+    }
+
+    static void AddQuadric(Quadric& dst, const Quadric& src)
+    {
+        dst.matrix += src.matrix;
+        dst.weight += src.weight;
+    }
+
+    // Returns squared distance from the position to the planes accumulated in both quadrics
+    static float EvaluateCollapse(const Quadric& a, const Quadric& b, const glm::vec3& position)
+    {
+        const float weight = a.weight + b.weight;
+
+        if (weight == 0.0f)
+        {
+            return 0.0f;
+        }
+
+        const glm::vec4 v(position, 1.0f);
+
+        return std::abs(glm::dot(v, (a.matrix + b.matrix) * v)) / weight;
+    }
+
+    static uint64_t GetEdgeKey(uint32_t a, uint32_t b)
+    {
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    // Open and non-manifold edges stay in place, this also keeps attribute seams intact
+    static std::vector<bool> FindLockedVertices(const DataView<uint32_t>& indices, size_t vertexCount)
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeCounts;
+        edgeCounts.reserve(indices.size);
+
+        for (size_t i = 0; i < indices.size; i += 3)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                ++edgeCounts[GetEdgeKey(indices.data[i + j], indices.data[i + (j + 1) % 3])];
+            }
+        }
+
+        std::vector<bool> lockedVertices(vertexCount, false);
+
+        for (size_t i = 0; i < indices.size; i += 3)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const uint32_t a = indices.data[i + j];
+                const uint32_t b = indices.data[i + (j + 1) % 3];
+
+                const auto it = edgeCounts.find(GetEdgeKey(b, a));
+
+                if (it == edgeCounts.end() || it->second != 1 || edgeCounts[GetEdgeKey(a, b)] != 1)
+                {
+                    lockedVertices[a] = true;
+                    lockedVertices[b] = true;
+                }
+            }
+        }
+
+        return lockedVertices;
+    }
+
+    static std::vector<EdgeCollapse> CollectEdgeCollapses(const DataView<uint32_t>& indices,
+            const DataView<glm::vec3>& positions, const std::vector<Quadric>& quadrics,
+            const std::vector<bool>& lockedVertices)
+    {
+        std::vector<EdgeCollapse> collapses;
+        collapses.reserve(indices.size / 2);
+
+        for (size_t i = 0; i < indices.size; i += 3)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const uint32_t a = indices.data[i + j];
+                const uint32_t b = indices.data[i + (j + 1) % 3];
+
+                // Each manifold edge is visited from both of its triangles
+                if (a > b || (lockedVertices[a] && lockedVertices[b]))
+                {
+                    continue;
+                }
+
+                const float costA = lockedVertices[a] ? std::numeric_limits<float>::max()
+                        : EvaluateCollapse(quadrics[a], quadrics[b], positions.data[b]);
+
+                const float costB = lockedVertices[b] ? std::numeric_limits<float>::max()
+                        : EvaluateCollapse(quadrics[a], quadrics[b], positions.data[a]);
+
+                collapses.push_back(costA <= costB ? EdgeCollapse{ a, b, costA } : EdgeCollapse{ b, a, costB });
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse& a, const EdgeCollapse& b)
+            {
+                return a.cost < b.cost;
+            });
+
+        return collapses;
+    }
+
+    static bool IsCollapseFlipping(const EdgeCollapse& collapse, const DataView<uint32_t>& indices,
+            const DataView<glm::vec3>& positions, const VertexTriangles& vertexTriangles,
+            const std::vector<uint32_t>& remap)
+    {
+        const uint32_t offset = vertexTriangles.offsets[collapse.source];
+
+        for (uint32_t i = 0; i < vertexTriangles.counts[collapse.source]; ++i)
+        {
+            const uint32_t* triangle = indices.data + vertexTriangles.triangles[offset + i] * 3;
+
+            std::array<uint32_t, 3> vertices{ remap[triangle[0]], remap[triangle[1]], remap[triangle[2]] };
+
+            if (std::find(vertices.begin(), vertices.end(), collapse.target) != vertices.end())
+            {
+                continue;
+            }
+
+            const glm::vec3& a = positions.data[vertices[0]];
+            const glm::vec3& b = positions.data[vertices[1]];
+            const glm::vec3& c = positions.data[vertices[2]];
+
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+
+            std::replace(vertices.begin(), vertices.end(), collapse.source, collapse.target);
+
+            const glm::vec3& collapsedA = positions.data[vertices[0]];
+            const glm::vec3& collapsedB = positions.data[vertices[1]];
+            const glm::vec3& collapsedC = positions.data[vertices[2]];
+
+            const glm::vec3 collapsedNormal = glm::cross(collapsedB - collapsedA, collapsedC - collapsedA);
+
+            if (glm::dot(normal, collapsedNormal) <= kMaxCollapseNormalDot)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
 }
 
 Mesh MeshHelpers::GenerateSphere(float radius, uint32_t sectorCount, uint32_t stackCount)
@@ -64,3 +613,549 @@ Mesh MeshHelpers::GenerateSphere(float radius)
 {
     return GenerateSphere(radius, Details::kDefaultSectorCount, Details::kDefaultStackCount);
 }
+
+std::vector<glm::vec3> MeshHelpers::CalculateNormals(const DataView<uint32_t>& indices,
+        const DataView<glm::vec3>& positions, uint32_t threadCount)
+{
+    Assert(indices.size % 3 == 0);
+
+    std::vector<glm::vec3> faceNormals(indices.size / 3);
+
+    Details::ForEachRange(faceNormals.size(), Details::kChunkSize, threadCount, [&](size_t begin, size_t end)
+        {
+            Details::CalculateFaceNormals(indices, positions, begin, end, faceNormals);
+        });
+
+    return Details::AccumulateFaceValues(indices, positions.size, faceNormals, Direction::kUp, threadCount);
+}
+
+std::vector<glm::vec3> MeshHelpers::CalculateTangents(const DataView<uint32_t>& indices,
+        const DataView<glm::vec3>& positions, const DataView<glm::vec2>& texCoords, uint32_t threadCount)
+{
+    Assert(indices.size % 3 == 0);
+    Assert(texCoords.size == positions.size);
+
+    std::vector<glm::vec3> faceTangents(indices.size / 3);
+
+    Details::ForEachRange(faceTangents.size(), Details::kChunkSize, threadCount, [&](size_t begin, size_t end)
+        {
+            Details::CalculateFaceTangents(indices, positions, texCoords, begin, end, faceTangents);
+        });
+
+    return Details::AccumulateFaceValues(indices, positions.size, faceTangents, Vector3::kX, threadCount);
+}
+
+std::vector<uint32_t> MeshHelpers::OptimizeVertexCache(const DataView<uint32_t>& indices, size_t vertexCount)
+{
+    Assert(indices.size % 3 == 0);
+
+    const size_t triangleCount = indices.size / 3;
+
+    Details::VertexTriangles vertexTriangles = Details::GetVertexTriangles(indices, vertexCount);
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        vertexScores[i] = Details::CalculateVertexScore(-1, vertexTriangles.counts[i]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        const uint32_t* triangle = indices.data + i * 3;
+
+        triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+    }
+
+    const auto updateVertexScore = [&](uint32_t vertex)
+        {
+            const float score = Details::CalculateVertexScore(cachePositions[vertex], vertexTriangles.counts[vertex]);
+            const float delta = score - vertexScores[vertex];
+
+            vertexScores[vertex] = score;
+
+            const uint32_t offset = vertexTriangles.offsets[vertex];
+
+            for (uint32_t i = 0; i < vertexTriangles.counts[vertex]; ++i)
+            {
+                triangleScores[vertexTriangles.triangles[offset + i]] += delta;
+            }
+        };
+
+    const auto removeTriangle = [&](uint32_t vertex, uint32_t triangle)
+        {
+            const uint32_t offset = vertexTriangles.offsets[vertex];
+            const uint32_t count = vertexTriangles.counts[vertex];
+
+            uint32_t* triangles = vertexTriangles.triangles.data() + offset;
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (triangles[i] == triangle)
+                {
+                    std::swap(triangles[i], triangles[count - 1]);
+                    --vertexTriangles.counts[vertex];
+                    break;
+                }
+            }
+        };
+
+    std::vector<bool> emittedTriangles(triangleCount, false);
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(Details::kOptimizationCacheSize + 3);
+    nextCache.reserve(Details::kOptimizationCacheSize + 3);
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size);
+
+    size_t bestTriangle = Details::kInvalidIndex;
+    if (triangleCount > 0)
+    {
+        const auto it = std::max_element(triangleScores.begin(), triangleScores.end());
+
+        bestTriangle = static_cast<size_t>(std::distance(triangleScores.begin(), it));
+    }
+
+    size_t nextTriangle = 0;
+
+    while (result.size() < indices.size)
+    {
+        if (bestTriangle == Details::kInvalidIndex)
+        {
+            while (emittedTriangles[nextTriangle])
+            {
+                ++nextTriangle;
+            }
+
+            bestTriangle = nextTriangle;
+        }
+
+        emittedTriangles[bestTriangle] = true;
+
+        const uint32_t* triangle = indices.data + bestTriangle * 3;
+
+        result.insert(result.end(), triangle, triangle + 3);
+
+        nextCache.clear();
+
+        for (size_t i = 0; i < 3; ++i)
+        {
+            removeTriangle(triangle[i], static_cast<uint32_t>(bestTriangle));
+
+            if (!Contains(nextCache, triangle[i]))
+            {
+                nextCache.push_back(triangle[i]);
+            }
+        }
+
+        for (const auto& vertex : cache)
+        {
+            if (!Contains(nextCache, vertex))
+            {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        for (size_t i = Details::kOptimizationCacheSize; i < nextCache.size(); ++i)
+        {
+            cachePositions[nextCache[i]] = -1;
+
+            updateVertexScore(nextCache[i]);
+        }
+
+        nextCache.resize(std::min(nextCache.size(), Details::kOptimizationCacheSize));
+
+        for (size_t i = 0; i < nextCache.size(); ++i)
+        {
+            cachePositions[nextCache[i]] = static_cast<int32_t>(i);
+
+            updateVertexScore(nextCache[i]);
+        }
+
+        std::swap(cache, nextCache);
+
+        bestTriangle = Details::kInvalidIndex;
+
+        float bestScore = 0.0f;
+
+        for (const auto& vertex : cache)
+        {
+            const uint32_t offset = vertexTriangles.offsets[vertex];
+
+            for (uint32_t i = 0; i < vertexTriangles.counts[vertex]; ++i)
+            {
+                const uint32_t candidate = vertexTriangles.triangles[offset + i];
+
+                if (bestTriangle == Details::kInvalidIndex || triangleScores[candidate] > bestScore)
+                {
+                    bestTriangle = candidate;
+                    bestScore = triangleScores[candidate];
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> MeshHelpers::OptimizeOverdraw(const DataView<uint32_t>& indices,
+        const DataView<glm::vec3>& positions)
+{
+    Assert(indices.size % 3 == 0);
+
+    const size_t triangleCount = indices.size / 3;
+
+    std::vector<size_t> clusterOffsets;
+
+    std::vector<uint32_t> cacheTimestamps(positions.size, 0);
+    uint32_t timestamp = Details::kAnalysisCacheSize + 1;
+
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        uint32_t missCount = 0;
+
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const uint32_t index = indices.data[i * 3 + j];
+
+            if (timestamp - cacheTimestamps[index] > Details::kAnalysisCacheSize)
+            {
+                cacheTimestamps[index] = timestamp++;
+                ++missCount;
+            }
+        }
+
+        if (i == 0 || missCount == 3)
+        {
+            clusterOffsets.push_back(i);
+        }
+    }
+
+    const glm::vec3 meshCentroid = Details::CalculateCentroid(positions);
+
+    std::vector<std::pair<float, size_t>> clusterKeys(clusterOffsets.size());
+
+    for (size_t i = 0; i < clusterOffsets.size(); ++i)
+    {
+        const size_t begin = clusterOffsets[i];
+        const size_t end = i + 1 < clusterOffsets.size() ? clusterOffsets[i + 1] : triangleCount;
+
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+
+        for (size_t j = begin; j < end; ++j)
+        {
+            const glm::vec3& position0 = positions.data[indices.data[j * 3]];
+            const glm::vec3& position1 = positions.data[indices.data[j * 3 + 1]];
+            const glm::vec3& position2 = positions.data[indices.data[j * 3 + 2]];
+
+            const glm::vec3 triangleNormal = glm::cross(position1 - position0, position2 - position0);
+            const float triangleArea = glm::length(triangleNormal);
+
+            centroid += (position0 + position1 + position2) * (triangleArea / 3.0f);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        float key = 0.0f;
+
+        if (area > 0.0f && glm::length(normal) > 0.0f)
+        {
+            key = glm::dot(centroid / area - meshCentroid, glm::normalize(normal));
+        }
+
+        clusterKeys[i] = std::make_pair(key, i);
+    }
+
+    std::stable_sort(clusterKeys.begin(), clusterKeys.end(), [](const auto& a, const auto& b)
+        {
+            return a.first > b.first;
+        });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size);
+
+    for (const auto& [key, cluster] : clusterKeys)
+    {
+        const size_t begin = clusterOffsets[cluster];
+        const size_t end = cluster + 1 < clusterOffsets.size() ? clusterOffsets[cluster + 1] : triangleCount;
+
+        result.insert(result.end(), indices.data + begin * 3, indices.data + end * 3);
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> MeshHelpers::OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    std::vector<uint32_t> remap(vertexCount, Details::kInvalidIndex);
+
+    uint32_t nextVertex = 0;
+
+    for (auto& index : indices)
+    {
+        Assert(index < vertexCount);
+
+        if (remap[index] == Details::kInvalidIndex)
+        {
+            remap[index] = nextVertex++;
+        }
+
+        index = remap[index];
+    }
+
+    return remap;
+}
+
+std::vector<uint32_t> MeshHelpers::SimplifyMesh(const DataView<uint32_t>& indices,
+        const DataView<glm::vec3>& positions, size_t targetIndexCount, float targetError, float& resultError)
+{
+    Assert(indices.size % 3 == 0);
+
+    std::vector<uint32_t> result(indices.data, indices.data + indices.size);
+
+    const std::vector<bool> lockedVertices = Details::FindLockedVertices(indices, positions.size);
+
+    std::vector<Details::Quadric> quadrics(positions.size);
+
+    for (size_t i = 0; i < indices.size; i += 3)
+    {
+        const Details::Quadric quadric = Details::CalculatePlaneQuadric(positions.data[indices.data[i]],
+                positions.data[indices.data[i + 1]], positions.data[indices.data[i + 2]]);
+
+        for (size_t j = 0; j < 3; ++j)
+        {
+            Details::AddQuadric(quadrics[indices.data[i + j]], quadric);
+        }
+    }
+
+    const float maxCost = targetError * targetError;
+
+    float maxCollapseCost = 0.0f;
+
+    std::vector<uint32_t> remap(positions.size);
+    std::vector<bool> collapsedVertices(positions.size);
+
+    // Every pass collapses a set of independent edges in the order of increasing cost
+    while (result.size() > targetIndexCount)
+    {
+        const DataView<uint32_t> currentIndices(result);
+
+        const std::vector<Details::EdgeCollapse> collapses = Details::CollectEdgeCollapses(
+                currentIndices, positions, quadrics, lockedVertices);
+
+        const Details::VertexTriangles vertexTriangles = Details::GetVertexTriangles(currentIndices, positions.size);
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(remap.size()); ++i)
+        {
+            remap[i] = i;
+        }
+
+        std::fill(collapsedVertices.begin(), collapsedVertices.end(), false);
+
+        size_t indexCount = result.size();
+        size_t collapseCount = 0;
+
+        for (const auto& collapse : collapses)
+        {
+            if (collapse.cost > maxCost || indexCount <= targetIndexCount)
+            {
+                break;
+            }
+
+            if (collapsedVertices[collapse.source] || collapsedVertices[collapse.target])
+            {
+                continue;
+            }
+
+            if (Details::IsCollapseFlipping(collapse, currentIndices, positions, vertexTriangles, remap))
+            {
+                continue;
+            }
+
+            const uint32_t offset = vertexTriangles.offsets[collapse.source];
+
+            for (uint32_t i = 0; i < vertexTriangles.counts[collapse.source]; ++i)
+            {
+                const uint32_t* triangle = result.data() + vertexTriangles.triangles[offset + i] * 3;
+
+                if (remap[triangle[0]] == collapse.target || remap[triangle[1]] == collapse.target
+                        || remap[triangle[2]] == collapse.target)
+                {
+                    indexCount -= 3;
+                }
+            }
+
+            remap[collapse.source] = collapse.target;
+
+            collapsedVertices[collapse.source] = true;
+            collapsedVertices[collapse.target] = true;
+
+            Details::AddQuadric(quadrics[collapse.target], quadrics[collapse.source]);
+
+            maxCollapseCost = std::max(maxCollapseCost, collapse.cost);
+
+            ++collapseCount;
+        }
+
+        if (collapseCount == 0)
+        {
+            break;
+        }
+
+        size_t writeIndex = 0;
+
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            const uint32_t a = remap[result[i]];
+            const uint32_t b = remap[result[i + 1]];
+            const uint32_t c = remap[result[i + 2]];
+
+            if (a != b && b != c && a != c)
+            {
+                result[writeIndex++] = a;
+                result[writeIndex++] = b;
+                result[writeIndex++] = c;
+            }
+        }
+
+        result.resize(writeIndex);
+    }
+
+    resultError = std::sqrt(maxCollapseCost);
+
+    return result;
+}
+
+std::vector<Meshlet> MeshHelpers::GenerateMeshlets(const DataView<uint32_t>& indices,
+        const DataView<glm::vec3>& positions, size_t maxVertexCount, size_t maxTriangleCount)
+{
+    Assert(maxVertexCount >= 3 && maxTriangleCount > 0);
+
+    std::vector<Meshlet> meshlets;
+
+    std::vector<uint32_t> meshletMarks(positions.size, Details::kInvalidIndex);
+
+    Meshlet meshlet{};
+    size_t meshletVertexCount = 0;
+
+    const auto flushMeshlet = [&]()
+        {
+            if (meshlet.indexCount > 0)
+            {
+                Details::CalculateMeshletBounds(meshlet, indices, positions);
+
+                meshlets.push_back(meshlet);
+            }
+
+            meshlet = Meshlet{};
+            meshlet.firstIndex = static_cast<uint32_t>(meshlets.empty() ? 0
+                    : meshlets.back().firstIndex + meshlets.back().indexCount);
+
+            meshletVertexCount = 0;
+        };
+
+    for (size_t i = 0; i + 2 < indices.size; i += 3)
+    {
+        const uint32_t meshletIndex = static_cast<uint32_t>(meshlets.size());
+
+        size_t newVertexCount = 0;
+        for (size_t j = 0; j < 3; ++j)
+        {
+            if (meshletMarks[indices.data[i + j]] != meshletIndex)
+            {
+                ++newVertexCount;
+            }
+        }
+
+        if (meshletVertexCount + newVertexCount > maxVertexCount || meshlet.indexCount / 3 >= maxTriangleCount)
+        {
+            flushMeshlet();
+        }
+
+        for (size_t j = 0; j < 3; ++j)
+        {
+            uint32_t& mark = meshletMarks[indices.data[i + j]];
+
+            if (mark != static_cast<uint32_t>(meshlets.size()))
+            {
+                mark = static_cast<uint32_t>(meshlets.size());
+                ++meshletVertexCount;
+            }
+        }
+
+        meshlet.indexCount += 3;
+    }
+
+    flushMeshlet();
+
+    return meshlets;
+}
+
+VertexCacheStatistics MeshHelpers::AnalyzeVertexCache(const DataView<uint32_t>& indices, size_t vertexCount)
+{
+    VertexCacheStatistics statistics;
+    statistics.triangleCount = indices.size / 3;
+    statistics.vertexCount = vertexCount;
+
+    std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+    uint32_t timestamp = Details::kAnalysisCacheSize + 1;
+
+    for (size_t i = 0; i < indices.size; ++i)
+    {
+        const uint32_t index = indices.data[i];
+
+        if (timestamp - cacheTimestamps[index] > Details::kAnalysisCacheSize)
+        {
+            cacheTimestamps[index] = timestamp++;
+            ++statistics.transformedVertexCount;
+        }
+    }
+
+    return statistics;
+}
+
+float VertexCacheStatistics::GetACMR() const
+{
+    return triangleCount > 0 ? static_cast<float>(transformedVertexCount) / static_cast<float>(triangleCount) : 0.0f;
+}
+
+float VertexCacheStatistics::GetATVR() const
+{
+    return vertexCount > 0 ? static_cast<float>(transformedVertexCount) / static_cast<float>(vertexCount) : 0.0f;
+}
+
+VertexCacheStatistics& VertexCacheStatistics::operator+=(const VertexCacheStatistics& other)
+{
+    transformedVertexCount += other.transformedVertexCount;
+    triangleCount += other.triangleCount;
+    vertexCount += other.vertexCount;
+
+    return *this;
+}
+
+glm::vec2 MeshHelpers::EncodeOctahedral(const glm::vec3& direction)
+{
+    const float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+
+    if (length == 0.0f)
+    {
+        return glm::vec2(0.0f);
+    }
+
+    const glm::vec3 octahedron = direction / length;
+
+    if (octahedron.z >= 0.0f)
+    {
+        return glm::vec2(octahedron.x, octahedron.y);
+    }
+
+    const glm::vec2 sign(octahedron.x >= 0.0f ? 1.0f : -1.0f, octahedron.y >= 0.0f ? 1.0f : -1.0f);
+
+    return (1.0f - glm::abs(glm::vec2(octahedron.y, octahedron.x))) * sign;
+}
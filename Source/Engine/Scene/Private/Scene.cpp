@@ -1,12 +1,66 @@
+#include <numeric>
+
 #include "Engine/Scene/Scene.hpp"
 
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 
+namespace Details
+{
+    static uint32_t GetPipelineStateKey(const Scene::PipelineState& pipelineState)
+    {
+        return static_cast<uint32_t>(pipelineState.alphaTest) | static_cast<uint32_t>(pipelineState.doubleSided) << 1;
+    }
+
+    static Scene::RenderQueue CreateRenderQueue(const Scene::Hierarchy& hierarchy)
+    {
+        const std::vector<Scene::RenderObject>& renderObjects = hierarchy.renderObjects;
+
+        const auto getSortKey = [&](uint32_t objectIndex)
+            {
+                const Scene::RenderObject& renderObject = renderObjects[objectIndex];
+                const Scene::Material& material = hierarchy.materials[renderObject.materialIndex];
+
+                return std::make_tuple(GetPipelineStateKey(material.pipelineState),
+                        renderObject.materialIndex, renderObject.meshIndex);
+            };
+
+        Scene::RenderQueue renderQueue;
+        renderQueue.objectIndices.resize(renderObjects.size());
+
+        std::iota(renderQueue.objectIndices.begin(), renderQueue.objectIndices.end(), 0);
+
+        std::stable_sort(renderQueue.objectIndices.begin(), renderQueue.objectIndices.end(),
+                [&](uint32_t a, uint32_t b) { return getSortKey(a) < getSortKey(b); });
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(renderQueue.objectIndices.size()); ++i)
+        {
+            const Scene::RenderObject& renderObject = renderObjects[renderQueue.objectIndices[i]];
+
+            if (!renderQueue.batches.empty())
+            {
+                Scene::RenderBatch& batch = renderQueue.batches.back();
+
+                if (batch.materialIndex == renderObject.materialIndex && batch.meshIndex == renderObject.meshIndex)
+                {
+                    ++batch.objectCount;
+                    continue;
+                }
+            }
+
+            renderQueue.batches.push_back(Scene::RenderBatch{
+                renderObject.materialIndex, renderObject.meshIndex, i, 1
+            });
+        }
+
+        return renderQueue;
+    }
+}
+
 const std::vector<vk::Format> Scene::Mesh::Vertex::kFormat{
-    vk::Format::eR32G32B32Sfloat,
-    vk::Format::eR32G32B32Sfloat,
-    vk::Format::eR32G32B32Sfloat,
-    vk::Format::eR32G32Sfloat,
+    vk::Format::eR16G16B16A16Unorm,
+    vk::Format::eR16G16Snorm,
+    vk::Format::eR16G16Snorm,
+    vk::Format::eR16G16Sfloat,
 };
 
 bool Scene::PipelineState::operator==(const PipelineState& other) const
@@ -16,7 +70,9 @@ bool Scene::PipelineState::operator==(const PipelineState& other) const
 
 Scene::Scene(const Description& description_)
     : description(description_)
-{}
+{
+    renderQueue = Details::CreateRenderQueue(description.hierarchy);
+}
 
 Scene::~Scene()
 {
@@ -27,39 +83,5 @@ Scene::~Scene()
         DescriptorHelpers::DestroyDescriptorSet(description.descriptorSets.pointLights.value());
     }
 
-    for (const auto& accelerationStructure : description.resources.accelerationStructures)
-    {
-        VulkanContext::accelerationStructureManager->DestroyAccelerationStructure(accelerationStructure);
-    }
-
-    for (const auto& buffer : description.resources.buffers)
-    {
-        VulkanContext::bufferManager->DestroyBuffer(buffer);
-    }
-
-    for (const auto& texture : description.resources.textures)
-    {
-        VulkanContext::textureManager->DestroyTexture(texture);
-    }
-
-    for (const auto& sampler : description.resources.samplers)
-    {
-        VulkanContext::textureManager->DestroySampler(sampler);
-    }
-}
-
-std::vector<Scene::RenderObject> Scene::GetRenderObjects(uint32_t materialIndex) const
-{
-    const std::vector<RenderObject>& renderObjects = description.hierarchy.renderObjects;
-
-    std::vector<RenderObject> result;
-
-    const auto pred = [materialIndex](const Scene::RenderObject& renderObject)
-        {
-            return renderObject.materialIndex == materialIndex;
-        };
-
-    std::copy_if(renderObjects.begin(), renderObjects.end(), std::back_inserter(result), pred);
-
-    return result;
+    SceneHelpers::DestroyResources(description.resources);
 }
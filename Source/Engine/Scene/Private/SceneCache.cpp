@@ -0,0 +1,408 @@
+#include <fstream>
+
+#include "Engine/Scene/SceneCache.hpp"
+
+#include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
+#include "Engine/Render/Vulkan/VulkanHelpers.hpp"
+
+#include "Utils/Assert.hpp"
+
+namespace Details
+{
+    static constexpr const char* kExtension = ".steelscene";
+
+    static constexpr uint32_t kMagic = 0x43535453;
+    static constexpr uint32_t kVersion = 5;
+
+    static constexpr uint64_t kAlignment = 16;
+
+    static constexpr uint32_t kMaxTextureDimension = 1 << 16;
+
+    struct Range
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t primitiveCount;
+        uint32_t textureCount;
+        uint64_t sourceTimestamp;
+        Range json;
+    };
+
+    struct PrimitiveRecord
+    {
+        Range vertices;
+        Range indices;
+        Range compactIndices;
+        Range positions;
+        Range normals;
+        Range tangents;
+        Range texCoords;
+        Range meshlets;
+        Range lods;
+        glm::vec3 positionOffset;
+        glm::vec3 positionScale;
+    };
+
+    struct TextureRecord
+    {
+        vk::Format format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipLevelCount;
+        Range data;
+    };
+
+    static uint64_t Align(uint64_t offset)
+    {
+        return (offset + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    static uint64_t GetMipLevelSize(vk::Format format, const vk::Extent2D& extent, uint32_t mipLevel)
+    {
+        const vk::Extent2D mipLevelExtent = ImageHelpers::CalculateMipLevelExtent(extent, mipLevel);
+
+        return ImageHelpers::CalculateDataSize(VulkanHelpers::GetExtent3D(mipLevelExtent), 1, format);
+    }
+
+    static bool IsSupportedFormat(vk::Format format)
+    {
+        switch (format)
+        {
+        case vk::Format::eR8Unorm:
+        case vk::Format::eR8G8Unorm:
+        case vk::Format::eR8G8B8Unorm:
+        case vk::Format::eR8G8B8A8Unorm:
+        case vk::Format::eBc1RgbUnormBlock:
+        case vk::Format::eBc3UnormBlock:
+        case vk::Format::eBc5UnormBlock:
+        case vk::Format::eBc7UnormBlock:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static bool IsValidRange(const ByteView& data, const Range& range)
+    {
+        return range.offset <= data.size && range.size <= data.size - range.offset;
+    }
+
+    static bool IsValidRecord(const ByteView& data, const PrimitiveRecord& record)
+    {
+        return IsValidRange(data, record.vertices)
+                && IsValidRange(data, record.indices)
+                && IsValidRange(data, record.compactIndices)
+                && IsValidRange(data, record.positions)
+                && IsValidRange(data, record.normals)
+                && IsValidRange(data, record.tangents)
+                && IsValidRange(data, record.texCoords)
+                && IsValidRange(data, record.meshlets)
+                && IsValidRange(data, record.lods);
+    }
+
+    static bool IsValidRecord(const ByteView& data, const TextureRecord& record)
+    {
+        if (!IsSupportedFormat(record.format) || !IsValidRange(data, record.data))
+        {
+            return false;
+        }
+
+        if (record.width == 0 || record.width > kMaxTextureDimension
+                || record.height == 0 || record.height > kMaxTextureDimension)
+        {
+            return false;
+        }
+
+        const vk::Extent2D extent(record.width, record.height);
+
+        if (record.mipLevelCount == 0 || record.mipLevelCount > ImageHelpers::CalculateMipLevelCount(extent))
+        {
+            return false;
+        }
+
+        uint64_t offset = record.data.offset;
+
+        for (uint32_t i = 0; i < record.mipLevelCount; ++i)
+        {
+            offset = Align(offset) + GetMipLevelSize(record.format, extent, i);
+
+            if (offset > record.data.offset + record.data.size)
+            {
+                return false;
+            }
+        }
+
+        return offset == record.data.offset + record.data.size;
+    }
+
+    static ByteView GetByteView(const ByteView& data, const Range& range)
+    {
+        Assert(IsValidRange(data, range));
+
+        return ByteView(data.data + range.offset, static_cast<size_t>(range.size));
+    }
+
+    template <class T>
+    static const T* GetRecords(const ByteView& data, uint64_t offset, uint32_t count)
+    {
+        Assert(IsValidRange(data, Range{ offset, sizeof(T) * static_cast<uint64_t>(count) }));
+
+        return reinterpret_cast<const T*>(data.data + offset);
+    }
+
+    class Layout
+    {
+    public:
+        Layout(uint64_t headerSize)
+            : offset(headerSize)
+        {}
+
+        Range Append(const ByteView& data)
+        {
+            offset = Align(offset);
+
+            const Range range{ offset, data.size };
+
+            blobs.emplace_back(range, data);
+
+            offset += data.size;
+
+            return range;
+        }
+
+        void Write(std::ofstream& file, uint64_t headerSize) const
+        {
+            static const std::array<char, kAlignment> kPadding{};
+
+            uint64_t position = headerSize;
+
+            for (const auto& [range, data] : blobs)
+            {
+                Assert(range.offset - position < kAlignment);
+
+                file.write(kPadding.data(), static_cast<std::streamsize>(range.offset - position));
+                file.write(reinterpret_cast<const char*>(data.data), static_cast<std::streamsize>(data.size));
+
+                position = range.offset + range.size;
+            }
+        }
+
+    private:
+        uint64_t offset;
+
+        std::vector<std::pair<Range, ByteView>> blobs;
+    };
+}
+
+Filepath SceneCache::GetCachePath(const Filepath& scenePath)
+{
+    if (scenePath.GetExtension() == Details::kExtension)
+    {
+        return scenePath;
+    }
+
+    return Filepath(scenePath.GetDirectory() + scenePath.GetBaseName() + Details::kExtension);
+}
+
+void SceneCache::Write(const Filepath& path, const Content& content)
+{
+    Details::Header header{
+        Details::kMagic, Details::kVersion,
+        static_cast<uint32_t>(content.primitives.size()),
+        static_cast<uint32_t>(content.textures.size()),
+        content.sourceTimestamp,
+        Details::Range{}
+    };
+
+    const uint64_t headerSize = sizeof(Details::Header)
+            + sizeof(Details::PrimitiveRecord) * header.primitiveCount
+            + sizeof(Details::TextureRecord) * header.textureCount;
+
+    Details::Layout layout(headerSize);
+
+    header.json = layout.Append(content.json);
+
+    std::vector<Details::PrimitiveRecord> primitiveRecords;
+    primitiveRecords.reserve(content.primitives.size());
+
+    for (const auto& primitive : content.primitives)
+    {
+        primitiveRecords.push_back(Details::PrimitiveRecord{
+            layout.Append(primitive.vertices),
+            layout.Append(primitive.indices),
+            layout.Append(primitive.compactIndices),
+            layout.Append(primitive.positions),
+            layout.Append(primitive.normals),
+            layout.Append(primitive.tangents),
+            layout.Append(primitive.texCoords),
+            layout.Append(primitive.meshlets),
+            layout.Append(primitive.lods),
+            primitive.positionOffset,
+            primitive.positionScale
+        });
+    }
+
+    std::vector<Details::TextureRecord> textureRecords;
+    textureRecords.reserve(content.textures.size());
+
+    for (const auto& texture : content.textures)
+    {
+        Details::TextureRecord textureRecord{
+            texture.format,
+            texture.extent.width,
+            texture.extent.height,
+            static_cast<uint32_t>(texture.mipLevels.size()),
+            Details::Range{}
+        };
+
+        Assert(Details::IsSupportedFormat(texture.format));
+
+        for (uint32_t i = 0; i < textureRecord.mipLevelCount; ++i)
+        {
+            const ByteView& mipLevel = texture.mipLevels[i];
+
+            Assert(mipLevel.size == Details::GetMipLevelSize(texture.format, texture.extent, i));
+
+            const Details::Range range = layout.Append(mipLevel);
+
+            if (textureRecord.data.size == 0)
+            {
+                textureRecord.data.offset = range.offset;
+            }
+
+            textureRecord.data.size = range.offset + range.size - textureRecord.data.offset;
+        }
+
+        textureRecords.push_back(textureRecord);
+    }
+
+    std::ofstream file(path.GetAbsolute(), std::ios::binary | std::ios::trunc);
+    Assert(file.is_open());
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Details::Header));
+    file.write(reinterpret_cast<const char*>(primitiveRecords.data()),
+            static_cast<std::streamsize>(sizeof(Details::PrimitiveRecord) * primitiveRecords.size()));
+    file.write(reinterpret_cast<const char*>(textureRecords.data()),
+            static_cast<std::streamsize>(sizeof(Details::TextureRecord) * textureRecords.size()));
+
+    layout.Write(file, headerSize);
+
+    Assert(file.good());
+}
+
+std::optional<SceneCache::Content> SceneCache::Read(const ByteView& data, std::optional<uint64_t> sourceTimestamp)
+{
+    if (data.size < sizeof(Details::Header))
+    {
+        return std::nullopt;
+    }
+
+    const Details::Header& header = *Details::GetRecords<Details::Header>(data, 0, 1);
+
+    if (header.magic != Details::kMagic || header.version != Details::kVersion)
+    {
+        return std::nullopt;
+    }
+
+    if (sourceTimestamp.has_value() && header.sourceTimestamp != sourceTimestamp.value())
+    {
+        return std::nullopt;
+    }
+
+    const uint64_t primitiveRecordsOffset = sizeof(Details::Header);
+    const uint64_t primitiveRecordsSize = sizeof(Details::PrimitiveRecord) * static_cast<uint64_t>(header.primitiveCount);
+
+    const uint64_t textureRecordsOffset = primitiveRecordsOffset + primitiveRecordsSize;
+    const uint64_t textureRecordsSize = sizeof(Details::TextureRecord) * static_cast<uint64_t>(header.textureCount);
+
+    if (!Details::IsValidRange(data, Details::Range{ primitiveRecordsOffset, primitiveRecordsSize })
+            || !Details::IsValidRange(data, Details::Range{ textureRecordsOffset, textureRecordsSize })
+            || !Details::IsValidRange(data, header.json))
+    {
+        return std::nullopt;
+    }
+
+    const Details::PrimitiveRecord* primitiveRecords = Details::GetRecords<Details::PrimitiveRecord>(
+            data, primitiveRecordsOffset, header.primitiveCount);
+
+    const Details::TextureRecord* textureRecords = Details::GetRecords<Details::TextureRecord>(
+            data, textureRecordsOffset, header.textureCount);
+
+    for (uint32_t i = 0; i < header.primitiveCount; ++i)
+    {
+        if (!Details::IsValidRecord(data, primitiveRecords[i]))
+        {
+            return std::nullopt;
+        }
+    }
+
+    for (uint32_t i = 0; i < header.textureCount; ++i)
+    {
+        if (!Details::IsValidRecord(data, textureRecords[i]))
+        {
+            return std::nullopt;
+        }
+    }
+
+    Content content;
+    content.sourceTimestamp = header.sourceTimestamp;
+    content.json = Details::GetByteView(data, header.json);
+
+    content.primitives.reserve(header.primitiveCount);
+
+    for (uint32_t i = 0; i < header.primitiveCount; ++i)
+    {
+        const Details::PrimitiveRecord& record = primitiveRecords[i];
+
+        content.primitives.push_back(PrimitiveData{
+            Details::GetByteView(data, record.vertices),
+            Details::GetByteView(data, record.indices),
+            Details::GetByteView(data, record.compactIndices),
+            Details::GetByteView(data, record.positions),
+            Details::GetByteView(data, record.normals),
+            Details::GetByteView(data, record.tangents),
+            Details::GetByteView(data, record.texCoords),
+            Details::GetByteView(data, record.meshlets),
+            Details::GetByteView(data, record.lods),
+            record.positionOffset,
+            record.positionScale
+        });
+    }
+
+    content.textures.reserve(header.textureCount);
+
+    for (uint32_t i = 0; i < header.textureCount; ++i)
+    {
+        const Details::TextureRecord& record = textureRecords[i];
+
+        const vk::Extent2D extent(record.width, record.height);
+
+        TextureData texture{ record.format, extent, {} };
+        texture.mipLevels.reserve(record.mipLevelCount);
+
+        uint64_t offset = record.data.offset;
+
+        for (uint32_t j = 0; j < record.mipLevelCount; ++j)
+        {
+            const uint64_t size = Details::GetMipLevelSize(record.format, extent, j);
+
+            offset = Details::Align(offset);
+
+            texture.mipLevels.push_back(Details::GetByteView(data, Details::Range{ offset, size }));
+
+            offset += size;
+        }
+
+        Assert(offset == record.data.offset + record.data.size);
+
+        content.textures.push_back(texture);
+    }
+
+    return content;
+}
@@ -5,12 +5,20 @@
 #include <tiny_gltf.h>
 #pragma warning(pop)
 
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
 #include "Engine/Scene/SceneModel.hpp"
 
 #include "Engine/Camera.hpp"
 #include "Engine/Scene/Scene.hpp"
 #include "Engine/Scene/ScenePT.hpp"
+#include "Engine/Scene/MeshHelpers.hpp"
+#include "Engine/Scene/SceneCache.hpp"
+#include "Engine/Scene/TextureCompression.hpp"
 #include "Engine/Filesystem/Filepath.hpp"
+#include "Engine/Filesystem/MappedFile.hpp"
 #include "Engine/Render/Vulkan/VulkanConfig.hpp"
 #include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
@@ -21,12 +29,16 @@
 
 #include "Shaders/Common/RayTracing.h"
 #include "Shaders/Hybrid/Hybrid.h"
+#include "Shaders/PathTracing/PathTracing.h"
 
 #include "Utils/Assert.hpp"
+#include "Utils/ThreadHelpers.hpp"
 #include "Utils/TimeHelpers.hpp"
 
 namespace Helpers
 {
+    using ModelBuffers = std::vector<ByteView>;
+
     static vk::Format GetFormat(const tinygltf::Image& image)
     {
         Assert(image.bits == 8);
@@ -95,19 +107,6 @@ namespace Helpers
         }
     }
 
-    static vk::IndexType GetIndexType(int32_t type)
-    {
-        switch (type)
-        {
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-            return vk::IndexType::eUint16;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-            return vk::IndexType::eUint32;
-        default:
-            return vk::IndexType::eNoneKHR;
-        }
-    }
-
     template <glm::length_t L>
     static glm::vec<L, float, glm::defaultp> GetVec(const std::vector<double>& values)
     {
@@ -173,32 +172,7 @@ namespace Helpers
     }
 
     template <class T>
-    static DataView<T> GetAccessorDataView(const tinygltf::Model& model,
-            const tinygltf::Accessor& accessor)
-    {
-        const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
-        Assert(bufferView.byteStride == 0 || bufferView.byteStride == GetAccessorValueSize(accessor));
-
-        const size_t offset = bufferView.byteOffset + accessor.byteOffset;
-        const T* data = reinterpret_cast<const T*>(model.buffers[bufferView.buffer].data.data() + offset);
-
-        return DataView<T>(data, accessor.count);
-    }
-
-    static ByteView GetAccessorByteView(const tinygltf::Model& model,
-            const tinygltf::Accessor& accessor)
-    {
-        const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
-        Assert(bufferView.byteStride == 0);
-
-        const size_t offset = bufferView.byteOffset + accessor.byteOffset;
-        const uint8_t* data = model.buffers[bufferView.buffer].data.data() + offset;
-
-        return DataView<uint8_t>(data, bufferView.byteLength - accessor.byteOffset);
-    }
-
-    template <class T>
-    static T GetAccessorValue(const tinygltf::Model& model,
+    static T GetAccessorValue(const tinygltf::Model& model, const ModelBuffers& buffers,
             const tinygltf::Accessor& accessor, size_t index)
     {
         const size_t size = GetAccessorValueSize(accessor);
@@ -210,7 +184,7 @@ namespace Helpers
         const size_t offset = bufferView.byteOffset + accessor.byteOffset;
         const size_t stride = bufferView.byteStride != 0 ? bufferView.byteStride : size;
 
-        const uint8_t* data = model.buffers[bufferView.buffer].data.data();
+        const uint8_t* data = buffers[bufferView.buffer].data;
 
         return *reinterpret_cast<const T*>(data + offset + stride * index);
     }
@@ -218,86 +192,80 @@ namespace Helpers
 
 namespace Details
 {
-    using NodeFunctor = std::function<void(int32_t, const glm::mat4&)>;
+    static constexpr size_t kMeshletMaxVertexCount = 64;
+    static constexpr size_t kMeshletMaxTriangleCount = 124;
 
-    static void CalculateNormals(const std::vector<uint32_t>& indices,
-            std::vector<Scene::Mesh::Vertex>& vertices)
+    static constexpr size_t kMaxMeshLodCount = 6;
+    static constexpr float kMeshLodReduction = 0.5f;
+    static constexpr float kMinMeshLodReduction = 0.85f;
+    static constexpr float kMaxMeshLodError = 0.1f;
+
+    struct Vertex
     {
-        for (auto& vertex : vertices)
-        {
-            vertex.normal = glm::vec3();
-        }
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec3 tangent;
+        glm::vec2 texCoord;
+    };
 
-        for (size_t i = 0; i < indices.size(); i = i + 3)
-        {
-            const glm::vec3& position0 = vertices[indices[i]].position;
-            const glm::vec3& position1 = vertices[indices[i + 1]].position;
-            const glm::vec3& position2 = vertices[indices[i + 2]].position;
+    struct MeshData
+    {
+        std::vector<uint32_t> indices;
+        std::vector<Vertex> vertices;
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshLod> lods;
+    };
+
+    struct PackedMeshData
+    {
+        std::vector<Scene::Mesh::Vertex> vertices;
+        std::vector<uint16_t> compactIndices;
+        glm::vec3 positionOffset;
+        glm::vec3 positionScale;
+    };
 
-            const glm::vec3 edge1 = position1 - position0;
-            const glm::vec3 edge2 = position2 - position0;
+    using NodeFunctor = std::function<void(int32_t, const glm::mat4&)>;
 
-            const glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+    static uint32_t GetPrimitiveThreadCount(uint32_t threadCount, size_t primitiveCount)
+    {
+        return std::max(threadCount / static_cast<uint32_t>(std::max(primitiveCount, size_t(1))), 1u);
+    }
 
-            vertices[indices[i]].normal += normal;
-            vertices[indices[i + 1]].normal += normal;
-            vertices[indices[i + 2]].normal += normal;
+    static void CalculateNormals(const std::vector<uint32_t>& indices,
+            std::vector<Vertex>& vertices, uint32_t threadCount)
+    {
+        std::vector<glm::vec3> positions(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            positions[i] = vertices[i].position;
         }
 
-        for (auto& vertex : vertices)
+        const std::vector<glm::vec3> normals = MeshHelpers::CalculateNormals(
+                DataView(indices), DataView(positions), threadCount);
+
+        for (size_t i = 0; i < vertices.size(); ++i)
         {
-            vertex.normal = glm::normalize(vertex.normal);
+            vertices[i].normal = normals[i];
         }
     }
 
     static void CalculateTangents(const std::vector<uint32_t>& indices,
-            std::vector<Scene::Mesh::Vertex>& vertices)
+            std::vector<Vertex>& vertices, uint32_t threadCount)
     {
-        for (auto& vertex : vertices)
+        std::vector<glm::vec3> positions(vertices.size());
+        std::vector<glm::vec2> texCoords(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
         {
-            vertex.tangent = glm::vec3();
+            positions[i] = vertices[i].position;
+            texCoords[i] = vertices[i].texCoord;
         }
 
-        for (size_t i = 0; i < indices.size(); i = i + 3)
-        {
-            const glm::vec3& position0 = vertices[indices[i]].position;
-            const glm::vec3& position1 = vertices[indices[i + 1]].position;
-            const glm::vec3& position2 = vertices[indices[i + 2]].position;
-
-            const glm::vec3 edge1 = position1 - position0;
-            const glm::vec3 edge2 = position2 - position0;
+        const std::vector<glm::vec3> tangents = MeshHelpers::CalculateTangents(
+                DataView(indices), DataView(positions), DataView(texCoords), threadCount);
 
-            const glm::vec2& texCoord0 = vertices[indices[i]].texCoord;
-            const glm::vec2& texCoord1 = vertices[indices[i + 1]].texCoord;
-            const glm::vec2& texCoord2 = vertices[indices[i + 2]].texCoord;
-
-            const glm::vec2 deltaTexCoord1 = texCoord1 - texCoord0;
-            const glm::vec2 deltaTexCoord2 = texCoord2 - texCoord0;
-
-            float d = deltaTexCoord1.x * deltaTexCoord2.y - deltaTexCoord1.y * deltaTexCoord2.x;
-
-            if (d == 0.0f)
-            {
-                d = 1.0f;
-            }
-
-            const glm::vec3 tangent = (edge1 * deltaTexCoord2.y - edge2 * deltaTexCoord1.y) / d;
-
-            vertices[indices[i]].tangent += tangent;
-            vertices[indices[i + 1]].tangent += tangent;
-            vertices[indices[i + 2]].tangent += tangent;
-        }
-
-        for (auto& vertex : vertices)
+        for (size_t i = 0; i < vertices.size(); ++i)
         {
-            if (glm::length(vertex.tangent) > 0.0f)
-            {
-                vertex.tangent = glm::normalize(vertex.tangent);
-            }
-            else
-            {
-                vertex.tangent.x = 1.0f;
-            }
+            vertices[i].tangent = tangents[i];
         }
     }
 
@@ -338,7 +306,7 @@ namespace Details
     }
 
     static std::vector<uint32_t> GetPrimitiveIndices(const tinygltf::Model& model,
-            const tinygltf::Primitive& primitive)
+            const Helpers::ModelBuffers& buffers, const tinygltf::Primitive& primitive)
     {
         const tinygltf::Accessor& accessor = model.accessors[primitive.indices];
 
@@ -347,64 +315,110 @@ namespace Details
         {
             if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
             {
-                indices[i] = Helpers::GetAccessorValue<uint32_t>(model, accessor, i);
+                indices[i] = Helpers::GetAccessorValue<uint32_t>(model, buffers, accessor, i);
             }
             else
             {
                 Assert(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT);
 
-                indices[i] = static_cast<uint32_t>(Helpers::GetAccessorValue<uint16_t>(model, accessor, i));
+                indices[i] = static_cast<uint32_t>(Helpers::GetAccessorValue<uint16_t>(model, buffers, accessor, i));
             }
         }
 
         return indices;
     }
 
-    static std::vector<Scene::Mesh::Vertex> GetPrimitiveVertices(const tinygltf::Model& model,
-            const tinygltf::Primitive& primitive)
+    static std::vector<Vertex> GetPrimitiveVertices(const tinygltf::Model& model,
+            const Helpers::ModelBuffers& buffers, const tinygltf::Primitive& primitive)
     {
         const tinygltf::Accessor& positionsAccessor = model.accessors[primitive.attributes.at("POSITION")];
 
-        std::vector<Scene::Mesh::Vertex> vertices(positionsAccessor.count);
+        std::vector<Vertex> vertices(positionsAccessor.count);
         for (size_t i = 0; i < vertices.size(); ++i)
         {
-            Scene::Mesh::Vertex& vertex = vertices[i];
+            Vertex& vertex = vertices[i];
 
-            vertex.position = Helpers::GetAccessorValue<glm::vec3>(model, positionsAccessor, i);
+            vertex.position = Helpers::GetAccessorValue<glm::vec3>(model, buffers, positionsAccessor, i);
 
             if (primitive.attributes.count("NORMAL") > 0)
             {
                 const tinygltf::Accessor& normalsAccessor = model.accessors[primitive.attributes.at("NORMAL")];
-                vertex.normal = Helpers::GetAccessorValue<glm::vec3>(model, normalsAccessor, i);
+                vertex.normal = Helpers::GetAccessorValue<glm::vec3>(model, buffers, normalsAccessor, i);
             }
 
             if (primitive.attributes.count("TANGENT") > 0)
             {
                 const tinygltf::Accessor& tangentsAccessor = model.accessors[primitive.attributes.at("TANGENT")];
-                vertex.tangent = Helpers::GetAccessorValue<glm::vec3>(model, tangentsAccessor, i);
+                vertex.tangent = Helpers::GetAccessorValue<glm::vec3>(model, buffers, tangentsAccessor, i);
             }
 
             if (primitive.attributes.count("TEXCOORD_0") > 0)
             {
                 const tinygltf::Accessor& texCoordsAccessor = model.accessors[primitive.attributes.at("TEXCOORD_0")];
-                vertex.texCoord = Helpers::GetAccessorValue<glm::vec2>(model, texCoordsAccessor, i);
+                vertex.texCoord = Helpers::GetAccessorValue<glm::vec2>(model, buffers, texCoordsAccessor, i);
             }
         }
 
         return vertices;
     }
 
-    static std::vector<Texture> CreateTextures(const tinygltf::Model& model)
+    static Texture CreateTexture(const SceneCache::TextureData& textureData)
+    {
+        const auto& [format, extent, mipLevels] = textureData;
+
+        if (mipLevels.size() > 1 || ImageHelpers::IsCompressedFormat(format))
+        {
+            return VulkanContext::textureManager->CreateTexture(format, extent, mipLevels);
+        }
+
+        return VulkanContext::textureManager->CreateTexture(format, extent, mipLevels.front());
+    }
+
+    static std::vector<Texture> CreateTextures(const std::vector<SceneCache::TextureData>& texturesData)
     {
         std::vector<Texture> textures;
-        textures.reserve(model.images.size());
+        textures.reserve(texturesData.size());
+
+        for (const auto& textureData : texturesData)
+        {
+            textures.push_back(CreateTexture(textureData));
+        }
+
+        return textures;
+    }
+
+    static size_t GetTextureSourceCount(const tinygltf::Model& model)
+    {
+        int32_t sourceCount = 0;
+
+        for (const auto& texture : model.textures)
+        {
+            sourceCount = std::max(sourceCount, texture.source + 1);
+        }
+
+        return static_cast<size_t>(sourceCount);
+    }
+
+    static std::vector<Texture> CreatePlaceholderTextures(const tinygltf::Model& model, size_t textureCount)
+    {
+        std::vector<Texture> textures(textureCount, Renderer::whiteTexture);
+
+        const auto setPlaceholder = [&](int32_t textureIndex, const Texture& placeholder)
+            {
+                if (textureIndex >= 0 && model.textures[textureIndex].source >= 0)
+                {
+                    textures[model.textures[textureIndex].source] = placeholder;
+                }
+            };
 
-        for (const auto& image : model.images)
+        for (const auto& material : model.materials)
         {
-            const vk::Format format = Helpers::GetFormat(image);
-            const vk::Extent2D extent = VulkanHelpers::GetExtent(image.width, image.height);
+            setPlaceholder(material.emissiveTexture.index, Renderer::blackTexture);
+        }
 
-            textures.push_back(VulkanContext::textureManager->CreateTexture(format, extent, ByteView(image.image)));
+        for (const auto& material : model.materials)
+        {
+            setPlaceholder(material.normalTexture.index, Renderer::normalTexture);
         }
 
         return textures;
@@ -435,46 +449,337 @@ namespace Details
         return samplers;
     }
 
-    static std::vector<Scene::Mesh> CreateMeshes(const tinygltf::Model& model)
+    static std::vector<const tinygltf::Primitive*> CollectPrimitives(const tinygltf::Model& model)
     {
-        std::vector<Scene::Mesh> meshes;
+        std::vector<const tinygltf::Primitive*> primitives;
 
         for (const auto& mesh : model.meshes)
         {
             for (const auto& primitive : mesh.primitives)
             {
+                primitives.push_back(&primitive);
+            }
+        }
+
+        return primitives;
+    }
+
+    static void OptimizeMesh(MeshData& meshData)
+    {
+        std::vector<glm::vec3> positions(meshData.vertices.size());
+        for (size_t i = 0; i < meshData.vertices.size(); ++i)
+        {
+            positions[i] = meshData.vertices[i].position;
+        }
+
+        meshData.indices = MeshHelpers::OptimizeVertexCache(DataView(meshData.indices), meshData.vertices.size());
+        meshData.indices = MeshHelpers::OptimizeOverdraw(DataView(meshData.indices), DataView(positions));
+
+        const std::vector<uint32_t> remap = MeshHelpers::OptimizeVertexFetch(meshData.indices, meshData.vertices.size());
+
+        meshData.vertices = MeshHelpers::RemapVertices(meshData.vertices, remap);
+    }
+
+    // LODs share the vertex buffer, their indices are appended after the base LOD
+    static void GenerateLods(MeshData& meshData)
+    {
+        std::vector<glm::vec3> positions(meshData.vertices.size());
+
+        glm::vec3 minPosition(std::numeric_limits<float>::max());
+        glm::vec3 maxPosition(std::numeric_limits<float>::lowest());
+
+        for (size_t i = 0; i < meshData.vertices.size(); ++i)
+        {
+            positions[i] = meshData.vertices[i].position;
+
+            minPosition = glm::min(minPosition, positions[i]);
+            maxPosition = glm::max(maxPosition, positions[i]);
+        }
+
+        const float maxError = glm::length(maxPosition - minPosition) * 0.5f * kMaxMeshLodError;
+
+        const std::vector<uint32_t> baseIndices = meshData.indices;
+
+        while (meshData.lods.size() < kMaxMeshLodCount)
+        {
+            const size_t previousIndexCount = meshData.lods.back().indexCount;
+
+            const size_t targetIndexCount = static_cast<size_t>(
+                    static_cast<float>(previousIndexCount / 3) * kMeshLodReduction) * 3;
+
+            float error = 0.0f;
+
+            std::vector<uint32_t> lodIndices = MeshHelpers::SimplifyMesh(DataView(baseIndices),
+                    DataView(positions), targetIndexCount, maxError, error);
+
+            if (lodIndices.empty() || static_cast<float>(lodIndices.size())
+                    > static_cast<float>(previousIndexCount) * kMinMeshLodReduction)
+            {
+                break;
+            }
+
+            if constexpr (Config::kOptimizeMeshes)
+            {
+                lodIndices = MeshHelpers::OptimizeVertexCache(DataView(lodIndices), meshData.vertices.size());
+            }
+
+            meshData.lods.push_back(MeshLod{
+                static_cast<uint32_t>(meshData.indices.size()),
+                static_cast<uint32_t>(lodIndices.size()),
+                0, 0, std::max(error, meshData.lods.back().error)
+            });
+
+            meshData.indices.insert(meshData.indices.end(), lodIndices.begin(), lodIndices.end());
+        }
+    }
+
+    static std::vector<Meshlet> GenerateMeshlets(MeshData& meshData)
+    {
+        std::vector<glm::vec3> positions(meshData.vertices.size());
+        for (size_t i = 0; i < meshData.vertices.size(); ++i)
+        {
+            positions[i] = meshData.vertices[i].position;
+        }
+
+        std::vector<Meshlet> meshlets;
+
+        for (auto& lod : meshData.lods)
+        {
+            const DataView<uint32_t> lodIndices(meshData.indices.data() + lod.firstIndex, lod.indexCount);
+
+            std::vector<Meshlet> lodMeshlets = MeshHelpers::GenerateMeshlets(lodIndices, DataView(positions),
+                    kMeshletMaxVertexCount, kMeshletMaxTriangleCount);
+
+            for (auto& meshlet : lodMeshlets)
+            {
+                meshlet.firstIndex += lod.firstIndex;
+            }
+
+            lod.firstMeshlet = static_cast<uint32_t>(meshlets.size());
+            lod.meshletCount = static_cast<uint32_t>(lodMeshlets.size());
+
+            meshlets.insert(meshlets.end(), lodMeshlets.begin(), lodMeshlets.end());
+        }
+
+        return meshlets;
+    }
+
+    static void LogMeshOptimization(const VertexCacheStatistics& original, const VertexCacheStatistics& optimized)
+    {
+        LogI << Format("Mesh optimization: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+                original.GetACMR(), optimized.GetACMR(), original.GetATVR(), optimized.GetATVR()) << "\n";
+    }
+
+    static PackedMeshData PackMesh(const MeshData& meshData)
+    {
+        glm::vec3 minPosition(std::numeric_limits<float>::max());
+        glm::vec3 maxPosition(std::numeric_limits<float>::lowest());
+
+        for (const auto& vertex : meshData.vertices)
+        {
+            minPosition = glm::min(minPosition, vertex.position);
+            maxPosition = glm::max(maxPosition, vertex.position);
+        }
+
+        PackedMeshData packedMeshData;
+        packedMeshData.positionOffset = minPosition;
+        packedMeshData.positionScale = glm::max(maxPosition - minPosition, 0.0f);
+
+        constexpr float kMaxPositionValue = static_cast<float>(std::numeric_limits<uint16_t>::max());
+
+        glm::vec3 positionFactor(0.0f);
+        for (glm::length_t i = 0; i < 3; ++i)
+        {
+            if (packedMeshData.positionScale[i] > 0.0f)
+            {
+                positionFactor[i] = kMaxPositionValue / packedMeshData.positionScale[i];
+            }
+        }
+
+        packedMeshData.vertices.reserve(meshData.vertices.size());
+
+        for (const auto& vertex : meshData.vertices)
+        {
+            const glm::vec3 position = glm::clamp(glm::round((vertex.position - minPosition) * positionFactor),
+                    0.0f, kMaxPositionValue);
+
+            packedMeshData.vertices.push_back(Scene::Mesh::Vertex{
+                glm::u16vec4(glm::u16vec3(position), 0),
+                glm::packSnorm2x16(MeshHelpers::EncodeOctahedral(vertex.normal)),
+                glm::packSnorm2x16(MeshHelpers::EncodeOctahedral(vertex.tangent)),
+                glm::packHalf2x16(vertex.texCoord)
+            });
+        }
+
+        if (meshData.vertices.size() <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1)
+        {
+            packedMeshData.compactIndices.reserve(meshData.indices.size());
+
+            for (const auto& index : meshData.indices)
+            {
+                packedMeshData.compactIndices.push_back(static_cast<uint16_t>(index));
+            }
+        }
+
+        return packedMeshData;
+    }
+
+    static std::vector<MeshData> DecodeMeshes(const tinygltf::Model& model,
+            const Helpers::ModelBuffers& buffers, uint32_t threadCount)
+    {
+        const std::vector<const tinygltf::Primitive*> primitives = CollectPrimitives(model);
+
+        std::vector<MeshData> meshesData(primitives.size());
+
+        std::vector<VertexCacheStatistics> originalStatistics(primitives.size());
+        std::vector<VertexCacheStatistics> optimizedStatistics(primitives.size());
+
+        const uint32_t primitiveThreadCount = GetPrimitiveThreadCount(threadCount, primitives.size());
+
+        ThreadHelpers::ParallelFor(primitives.size(), threadCount, [&](size_t i)
+            {
+                const tinygltf::Primitive& primitive = *primitives[i];
+
                 Assert(primitive.mode == TINYGLTF_MODE_TRIANGLES);
                 Assert(primitive.indices >= 0);
 
-                const std::vector<uint32_t> indices = GetPrimitiveIndices(model, primitive);
+                MeshData& meshData = meshesData[i];
 
-                std::vector<Scene::Mesh::Vertex> vertices = GetPrimitiveVertices(model, primitive);
+                meshData.indices = GetPrimitiveIndices(model, buffers, primitive);
+                meshData.vertices = GetPrimitiveVertices(model, buffers, primitive);
 
                 if (primitive.attributes.count("NORMAL") == 0)
                 {
-                    CalculateNormals(indices, vertices);
+                    CalculateNormals(meshData.indices, meshData.vertices, primitiveThreadCount);
                 }
                 if (primitive.attributes.count("TANGENT") == 0)
                 {
-                    CalculateTangents(indices, vertices);
+                    CalculateTangents(meshData.indices, meshData.vertices, primitiveThreadCount);
                 }
 
-                const vk::Buffer indexBuffer = BufferHelpers::CreateBufferWithData(
-                        vk::BufferUsageFlagBits::eIndexBuffer, ByteView(indices));
+                if constexpr (Config::kOptimizeMeshes)
+                {
+                    originalStatistics[i] = MeshHelpers::AnalyzeVertexCache(
+                            DataView(meshData.indices), meshData.vertices.size());
 
-                const vk::Buffer vertexBuffer = BufferHelpers::CreateBufferWithData(
-                        vk::BufferUsageFlagBits::eVertexBuffer, ByteView(vertices));
+                    OptimizeMesh(meshData);
 
-                meshes.push_back(Scene::Mesh{
-                    vk::IndexType::eUint32, indexBuffer, static_cast<uint32_t>(indices.size()),
-                    vertexBuffer, static_cast<uint32_t>(vertices.size())
-                });
+                    optimizedStatistics[i] = MeshHelpers::AnalyzeVertexCache(
+                            DataView(meshData.indices), meshData.vertices.size());
+                }
+
+                meshData.lods = { MeshLod{ 0, static_cast<uint32_t>(meshData.indices.size()), 0, 0, 0.0f } };
+
+                if constexpr (Config::kMeshLods)
+                {
+                    GenerateLods(meshData);
+                }
+
+                meshData.meshlets = GenerateMeshlets(meshData);
+            });
+
+        if constexpr (Config::kOptimizeMeshes)
+        {
+            VertexCacheStatistics original;
+            VertexCacheStatistics optimized;
+
+            for (size_t i = 0; i < primitives.size(); ++i)
+            {
+                original += originalStatistics[i];
+                optimized += optimizedStatistics[i];
             }
+
+            LogMeshOptimization(original, optimized);
+        }
+
+        return meshesData;
+    }
+
+    static std::vector<Scene::Mesh> CreateMeshes(const std::vector<SceneCache::PrimitiveData>& primitives)
+    {
+        std::vector<BufferHelpers::BufferData> buffersData;
+        buffersData.reserve(primitives.size() * 2);
+
+        for (const auto& primitive : primitives)
+        {
+            const ByteView indices = primitive.compactIndices.size > 0 ? primitive.compactIndices : primitive.indices;
+
+            buffersData.emplace_back(vk::BufferUsageFlagBits::eIndexBuffer, indices);
+            buffersData.emplace_back(vk::BufferUsageFlagBits::eVertexBuffer, primitive.vertices);
+        }
+
+        const std::vector<vk::Buffer> buffers = BufferHelpers::CreateBuffersWithData(buffersData);
+
+        std::vector<Scene::Mesh> meshes;
+        meshes.reserve(primitives.size());
+
+        uint32_t meshletOffset = 0;
+        uint32_t lodOffset = 0;
+
+        for (size_t i = 0; i < primitives.size(); ++i)
+        {
+            const SceneCache::PrimitiveData& primitive = primitives[i];
+
+            const DataView<Scene::Mesh::Vertex> vertices(primitive.vertices);
+            const DataView<Meshlet> meshlets(primitive.meshlets);
+            const DataView<MeshLod> lods(primitive.lods);
+
+            const vk::IndexType indexType = primitive.compactIndices.size > 0
+                    ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
+
+            meshes.push_back(Scene::Mesh{
+                indexType, buffers[i * 2], lods.data[0].indexCount,
+                buffers[i * 2 + 1], static_cast<uint32_t>(vertices.size),
+                primitive.positionOffset, primitive.positionScale,
+                meshletOffset, static_cast<uint32_t>(meshlets.size),
+                lodOffset, static_cast<uint32_t>(lods.size)
+            });
+
+            meshletOffset += static_cast<uint32_t>(meshlets.size);
+            lodOffset += static_cast<uint32_t>(lods.size);
         }
 
         return meshes;
     }
 
+    static std::vector<MeshLod> CreateMeshLods(const std::vector<SceneCache::PrimitiveData>& primitives)
+    {
+        std::vector<MeshLod> lods;
+
+        for (const auto& primitive : primitives)
+        {
+            const DataView<MeshLod> primitiveLods(primitive.lods);
+
+            lods.insert(lods.end(), primitiveLods.data, primitiveLods.data + primitiveLods.size);
+        }
+
+        return lods;
+    }
+
+    // Ray tracing always uses the base LOD, simplified LODs are rasterized only
+    static ByteView GetBaseIndices(const SceneCache::PrimitiveData& primitive)
+    {
+        const DataView<MeshLod> lods(primitive.lods);
+
+        Assert(lods.size > 0);
+
+        return ByteView(primitive.indices.data, sizeof(uint32_t) * lods.data[0].indexCount);
+    }
+
+    static std::vector<Meshlet> CreateMeshlets(const std::vector<SceneCache::PrimitiveData>& primitives)
+    {
+        std::vector<Meshlet> meshlets;
+
+        for (const auto& primitive : primitives)
+        {
+            const DataView<Meshlet> primitiveMeshlets(primitive.meshlets);
+
+            meshlets.insert(meshlets.end(), primitiveMeshlets.data, primitiveMeshlets.data + primitiveMeshlets.size);
+        }
+
+        return meshlets;
+    }
+
     static std::vector<Scene::Material> CreateMaterials(const tinygltf::Model& model)
     {
         std::vector<Scene::Material> materials;
@@ -613,24 +918,70 @@ namespace Details
         return buffers;
     }
 
-    static MultiDescriptorSet CreateMaterialsDescriptorSet(const tinygltf::Model& model,
-            const Scene::Hierarchy& hierarchy, const Scene::Resources& resources)
+    static DescriptorSetData GetMaterialTexturesData(const tinygltf::Model& model, const Scene::Material& material,
+            const std::vector<Texture>& textures, const std::vector<vk::Sampler>& samplers)
     {
-        const DescriptorSetDescription descriptorSetDescription{
-            DescriptorDescription{
-                1, vk::DescriptorType::eCombinedImageSampler,
-                vk::ShaderStageFlagBits::eFragment,
-                vk::DescriptorBindingFlags()
-            },
-            DescriptorDescription{
-                1, vk::DescriptorType::eCombinedImageSampler,
-                vk::ShaderStageFlagBits::eFragment,
-                vk::DescriptorBindingFlags()
-            },
-            DescriptorDescription{
-                1, vk::DescriptorType::eCombinedImageSampler,
-                vk::ShaderStageFlagBits::eFragment,
-                vk::DescriptorBindingFlags()
+        const std::array<Texture, Scene::Material::kTextureCount> placeholders{
+            Renderer::whiteTexture,
+            Renderer::whiteTexture,
+            Renderer::normalTexture,
+            Renderer::whiteTexture,
+            Renderer::whiteTexture
+        };
+
+        const std::array<int32_t, Scene::Material::kTextureCount> textureIndices{
+            material.baseColorTexture,
+            material.roughnessMetallicTexture,
+            material.normalTexture,
+            material.occlusionTexture,
+            material.emissionTexture
+        };
+
+        DescriptorSetData descriptorSetData(Scene::Material::kTextureCount);
+        for (uint32_t i = 0; i < Scene::Material::kTextureCount; ++i)
+        {
+            vk::Sampler sampler = Renderer::defaultSampler;
+            vk::ImageView view = placeholders[i].view;
+
+            if (textureIndices[i] >= 0)
+            {
+                const tinygltf::Texture& texture = model.textures[textureIndices[i]];
+
+                if (texture.sampler >= 0)
+                {
+                    sampler = samplers[texture.sampler];
+                }
+                if (texture.source >= 0)
+                {
+                    view = textures[texture.source].view;
+                }
+            }
+
+            descriptorSetData[i] = DescriptorHelpers::GetData(sampler, view);
+        }
+
+        return descriptorSetData;
+    }
+
+    static MultiDescriptorSet CreateMaterialsDescriptorSet(const tinygltf::Model& model,
+            const Scene::Hierarchy& hierarchy, const std::vector<Texture>& textures,
+            const std::vector<vk::Sampler>& samplers)
+    {
+        const DescriptorSetDescription descriptorSetDescription{
+            DescriptorDescription{
+                1, vk::DescriptorType::eCombinedImageSampler,
+                vk::ShaderStageFlagBits::eFragment,
+                vk::DescriptorBindingFlags()
+            },
+            DescriptorDescription{
+                1, vk::DescriptorType::eCombinedImageSampler,
+                vk::ShaderStageFlagBits::eFragment,
+                vk::DescriptorBindingFlags()
+            },
+            DescriptorDescription{
+                1, vk::DescriptorType::eCombinedImageSampler,
+                vk::ShaderStageFlagBits::eFragment,
+                vk::DescriptorBindingFlags()
             },
             DescriptorDescription{
                 1, vk::DescriptorType::eCombinedImageSampler,
@@ -652,79 +1003,51 @@ namespace Details
         std::vector<DescriptorSetData> multiDescriptorSetData;
         multiDescriptorSetData.reserve(hierarchy.materials.size());
 
-        std::array<Texture, Scene::Material::kTextureCount> placeholders{
-            Renderer::whiteTexture,
-            Renderer::whiteTexture,
-            Renderer::normalTexture,
-            Renderer::whiteTexture,
-            Renderer::whiteTexture
-        };
-
-        std::array<std::optional<tinygltf::Texture>, Scene::Material::kTextureCount> textures;
-
         for (const auto& material : hierarchy.materials)
         {
-            textures.fill(std::nullopt);
-
-            if (material.baseColorTexture >= 0)
-            {
-                textures[0] = model.textures[material.baseColorTexture];
-            }
-            if (material.roughnessMetallicTexture >= 0)
-            {
-                textures[1] = model.textures[material.roughnessMetallicTexture];
-            }
-            if (material.normalTexture >= 0)
-            {
-                textures[2] = model.textures[material.normalTexture];
-            }
-            if (material.occlusionTexture >= 0)
-            {
-                textures[3] = model.textures[material.occlusionTexture];
-            }
-            if (material.emissionTexture >= 0)
-            {
-                textures[4] = model.textures[material.emissionTexture];
-            }
+            DescriptorSetData descriptorSetData = GetMaterialTexturesData(model, material, textures, samplers);
 
-            DescriptorSetData descriptorSetData(Scene::Material::kTextureCount + 1);
-            for (uint32_t i = 0; i < Scene::Material::kTextureCount; ++i)
-            {
-                vk::Sampler sampler = Renderer::defaultSampler;
-                vk::ImageView view = placeholders[i].view;
+            descriptorSetData.push_back(DescriptorHelpers::GetData(material.buffer));
 
-                if (textures[i].has_value())
-                {
-                    if (textures[i]->sampler >= 0)
-                    {
-                        sampler = resources.samplers[textures[i]->sampler];
-                    }
-                    if (textures[i]->source >= 0)
-                    {
-                        view = resources.textures[textures[i]->source].view;
-                    }
-                }
+            multiDescriptorSetData.push_back(descriptorSetData);
+        }
 
-                descriptorSetData[i] = DescriptorHelpers::GetData(sampler, view);
-            }
+        return DescriptorHelpers::CreateMultiDescriptorSet(descriptorSetDescription, multiDescriptorSetData);
+    }
 
-            descriptorSetData.back() = DescriptorHelpers::GetData(material.buffer);
+    static void UpdateMaterialsDescriptorSet(const tinygltf::Model& model, const Scene::Hierarchy& hierarchy,
+            const MultiDescriptorSet& descriptorSet, const std::vector<Texture>& textures,
+            const std::vector<vk::Sampler>& samplers)
+    {
+        for (size_t i = 0; i < hierarchy.materials.size(); ++i)
+        {
+            const DescriptorSetData descriptorSetData
+                    = GetMaterialTexturesData(model, hierarchy.materials[i], textures, samplers);
 
-            multiDescriptorSetData.push_back(descriptorSetData);
+            VulkanContext::descriptorPool->UpdateDescriptorSet(descriptorSet.values[i], descriptorSetData, 0);
         }
+    }
 
-        return DescriptorHelpers::CreateMultiDescriptorSet(descriptorSetDescription, multiDescriptorSetData);
+    static void LogMemoryUsage(const std::string& label, const SceneResources& resources)
+    {
+        const vk::DeviceSize memorySize = SceneHelpers::CalculateMemorySize(resources);
+
+        LogI << Format("%s: %.2f MB", label.c_str(),
+                static_cast<float>(memorySize) / static_cast<float>(Numbers::kMegabyte)) << "\n";
     }
 
     static DescriptorSet CreatePointLightsDescriptorSet(vk::Buffer pointLightsBuffer)
     {
         const DescriptorDescription descriptorDescription{
-            1, vk::DescriptorType::eUniformBuffer,
+            1, vk::DescriptorType::eStorageBuffer,
             vk::ShaderStageFlagBits::eCompute,
             vk::DescriptorBindingFlags()
         };
 
-        const DescriptorData descriptorData = DescriptorHelpers::GetData(pointLightsBuffer);
+        const DescriptorData descriptorData{
+            vk::DescriptorType::eStorageBuffer,
+            BufferInfo{ vk::DescriptorBufferInfo(pointLightsBuffer, 0, VK_WHOLE_SIZE) }
+        };
 
         return DescriptorHelpers::CreateDescriptorSet({ descriptorDescription }, { descriptorData });
     }
@@ -734,6 +1057,7 @@ namespace DetailsRT
 {
     enum class GeometryAttribute
     {
+        ePositions,
         eIndices,
         eNormals,
         eTangents,
@@ -751,6 +1075,11 @@ namespace DetailsRT
         vk::Buffer buffer;
     };
 
+    struct InstancesData
+    {
+        vk::Buffer buffer;
+    };
+
     struct TexturesData
     {
         std::vector<Texture> textures;
@@ -760,14 +1089,28 @@ namespace DetailsRT
 
     struct GeometryData
     {
-        std::vector<vk::Buffer> buffers;
-        std::map<GeometryAttribute, BufferInfo> descriptorsInfo;
+        std::map<GeometryAttribute, vk::Buffer> buffers;
+    };
+
+    struct PrimitiveOffsets
+    {
+        std::vector<uint32_t> indexOffsets;
+        std::vector<uint32_t> vertexOffsets;
+    };
+
+    struct PrimitiveGeometry
+    {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec3> tangents;
+        std::vector<glm::vec2> texCoords;
     };
 
     struct RayTracingData
     {
         AccelerationData acceleration;
         MaterialsData materials;
+        InstancesData instances;
         TexturesData textures;
         GeometryData geometry;
     };
@@ -783,9 +1126,20 @@ namespace DetailsRT
         GeometryAttribute::eIndices, GeometryAttribute::eTexCoords
     };
 
-    static uint32_t GetCustomIndex(uint16_t instanceIndex, uint8_t materialIndex)
+    // Positions are only read by BLAS builds and are released afterwards
+    static const std::vector<GeometryAttribute> kBuildGeometryAttributes{
+        GeometryAttribute::ePositions, GeometryAttribute::eIndices, GeometryAttribute::eNormals,
+        GeometryAttribute::eTangents, GeometryAttribute::eTexCoords
+    };
+
+    constexpr uint32_t kTexturesBinding = 3;
+
+    static DescriptorData GetStorageBufferData(vk::Buffer buffer)
     {
-        return static_cast<uint32_t>(instanceIndex) | (static_cast<uint32_t>(materialIndex) << 16);
+        return DescriptorData{
+            vk::DescriptorType::eStorageBuffer,
+            BufferInfo{ vk::DescriptorBufferInfo(buffer, 0, VK_WHOLE_SIZE) }
+        };
     }
 
     static vk::GeometryInstanceFlagsKHR GetGeometryInstanceFlags(const tinygltf::Material& material)
@@ -804,72 +1158,69 @@ namespace DetailsRT
         return flags;
     }
 
-    static GeometryVertexData CreateGeometryPositions(const tinygltf::Model& model,
-            const tinygltf::Primitive& primitive)
+    static PrimitiveOffsets GetPrimitiveOffsets(const std::vector<SceneCache::PrimitiveData>& primitives)
     {
-        Assert(primitive.mode == TINYGLTF_MODE_TRIANGLES);
-
-        const tinygltf::Accessor accessor = model.accessors[primitive.attributes.at("POSITION")];
-        const DataView<glm::vec3> data = Helpers::GetAccessorDataView<glm::vec3>(model, accessor);
+        PrimitiveOffsets primitiveOffsets{
+            std::vector<uint32_t>(primitives.size()),
+            std::vector<uint32_t>(primitives.size())
+        };
 
-        const vk::Buffer buffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eShaderDeviceAddressEXT, ByteView(data));
+        for (size_t i = 1; i < primitives.size(); ++i)
+        {
+            const DataView<uint32_t> indicesData(Details::GetBaseIndices(primitives[i - 1]));
+            const DataView<glm::vec3> positionsData(primitives[i - 1].positions);
 
-        const GeometryVertexData vertices{
-            buffer,
-            vk::Format::eR32G32B32Sfloat,
-            static_cast<uint32_t>(accessor.count),
-            sizeof(glm::vec3)
-        };
+            primitiveOffsets.indexOffsets[i] = primitiveOffsets.indexOffsets[i - 1]
+                    + static_cast<uint32_t>(indicesData.size);
+            primitiveOffsets.vertexOffsets[i] = primitiveOffsets.vertexOffsets[i - 1]
+                    + static_cast<uint32_t>(positionsData.size);
+        }
 
-        return vertices;
+        return primitiveOffsets;
     }
 
-    static GeometryIndexData CreateGeometryIndices(const tinygltf::Model& model,
-            const tinygltf::Primitive& primitive)
+    // BLASes are built straight from the packed geometry buffers
+    static AccelerationStructures GenerateBlases(const std::vector<SceneCache::PrimitiveData>& primitives,
+            const GeometryData& geometryData)
     {
-        Assert(primitive.indices >= 0);
-
-        const tinygltf::Accessor accessor = model.accessors[primitive.indices];
-        const ByteView data = Helpers::GetAccessorByteView(model, accessor);
-
-        const vk::Buffer buffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eShaderDeviceAddressEXT, data);
-
-        const GeometryIndexData indices{
-            buffer,
-            Helpers::GetIndexType(accessor.componentType),
-            static_cast<uint32_t>(accessor.count)
-        };
+        const PrimitiveOffsets primitiveOffsets = GetPrimitiveOffsets(primitives);
 
-        return indices;
-    }
+        const vk::Buffer positionsBuffer = geometryData.buffers.at(GeometryAttribute::ePositions);
+        const vk::Buffer indicesBuffer = geometryData.buffers.at(GeometryAttribute::eIndices);
 
-    static AccelerationStructures GenerateBlases(const tinygltf::Model& model)
-    {
-        std::vector<vk::AccelerationStructureKHR> blases;
-        blases.reserve(model.meshes.size());
+        std::vector<BlasGeometryData> geometries;
+        geometries.reserve(primitives.size());
 
-        for (const auto& mesh : model.meshes)
+        for (size_t i = 0; i < primitives.size(); ++i)
         {
-            for (const auto& primitive : mesh.primitives)
-            {
-                const GeometryVertexData vertices = CreateGeometryPositions(model, primitive);
-                const GeometryIndexData indices = CreateGeometryIndices(model, primitive);
+            const DataView<glm::vec3> positionsData(primitives[i].positions);
+            const DataView<uint32_t> indicesData(Details::GetBaseIndices(primitives[i]));
+
+            const GeometryVertexData vertices{
+                positionsBuffer,
+                sizeof(glm::vec3) * static_cast<vk::DeviceSize>(primitiveOffsets.vertexOffsets[i]),
+                vk::Format::eR32G32B32Sfloat,
+                static_cast<uint32_t>(positionsData.size),
+                sizeof(glm::vec3)
+            };
 
-                blases.push_back(VulkanContext::accelerationStructureManager->GenerateBlas(vertices, indices));
+            const GeometryIndexData indices{
+                indicesBuffer,
+                sizeof(uint32_t) * static_cast<vk::DeviceSize>(primitiveOffsets.indexOffsets[i]),
+                vk::IndexType::eUint32,
+                static_cast<uint32_t>(indicesData.size)
+            };
 
-                VulkanContext::bufferManager->DestroyBuffer(vertices.buffer);
-                VulkanContext::bufferManager->DestroyBuffer(indices.buffer);
-            }
+            geometries.push_back(BlasGeometryData{ vertices, indices });
         }
 
-        return blases;
+        return VulkanContext::accelerationStructureManager->GenerateBlases(geometries, Config::kCompactBlases);
     }
 
-    static AccelerationData CreateAccelerationData(const tinygltf::Model& model)
+    static AccelerationData CreateAccelerationData(const tinygltf::Model& model,
+            const std::vector<SceneCache::PrimitiveData>& primitives, const GeometryData& geometryData)
     {
-        const std::vector<vk::AccelerationStructureKHR> blases = GenerateBlases(model);
+        const std::vector<vk::AccelerationStructureKHR> blases = GenerateBlases(primitives, geometryData);
 
         std::vector<GeometryInstanceData> instances;
 
@@ -887,15 +1238,12 @@ namespace DetailsRT
 
                         const vk::AccelerationStructureKHR blas = blases[meshOffset + i];
 
-                        const uint16_t instanceIndex = static_cast<uint16_t>(instances.size());
-                        const uint8_t materialIndex = static_cast<uint8_t>(mesh.primitives[i].material);
-
-                        const tinygltf::Material& material = model.materials[materialIndex];
+                        const tinygltf::Material& material = model.materials[mesh.primitives[i].material];
 
+                        // Shaders find instance records by gl_InstanceID, the custom index is unused
                         const GeometryInstanceData instance{
-                            blas, transform,
-                            GetCustomIndex(instanceIndex, materialIndex),
-                            0xFF, 0, GetGeometryInstanceFlags(material)
+                            blas, transform, 0, 0xFF, 0,
+                            GetGeometryInstanceFlags(material)
                         };
 
                         instances.push_back(instance);
@@ -934,16 +1282,54 @@ namespace DetailsRT
         }
 
         const vk::Buffer buffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eUniformBuffer, ByteView(materialsData));
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(materialsData));
 
         return MaterialsData{ buffer };
     }
 
-    static TexturesData CreateTexturesData(const tinygltf::Model& model)
+    // Records follow the TLAS instance order of CreateAccelerationData
+    static InstancesData CreateInstancesData(const tinygltf::Model& model,
+            const std::vector<SceneCache::PrimitiveData>& primitives)
     {
-        const std::vector<Texture> textures = Details::CreateTextures(model);
-        const std::vector<vk::Sampler> samplers = Details::CreateSamplers(model);
+        const PrimitiveOffsets primitiveOffsets = GetPrimitiveOffsets(primitives);
+
+        std::vector<InstanceRT> instancesData;
+
+        Details::EnumerateNodes(model, [&](int32_t nodeIndex, const glm::mat4&)
+            {
+                const tinygltf::Node& node = model.nodes[nodeIndex];
 
+                if (node.mesh >= 0)
+                {
+                    const tinygltf::Mesh& mesh = model.meshes[node.mesh];
+
+                    const uint32_t meshOffset = Details::CalculateMeshOffset(model, node.mesh);
+
+                    for (size_t i = 0; i < mesh.primitives.size(); ++i)
+                    {
+                        instancesData.push_back(InstanceRT{
+                            static_cast<uint32_t>(mesh.primitives[i].material),
+                            primitiveOffsets.indexOffsets[meshOffset + i],
+                            primitiveOffsets.vertexOffsets[meshOffset + i]
+                        });
+                    }
+                }
+            });
+
+        if (instancesData.empty())
+        {
+            instancesData.push_back(InstanceRT{});
+        }
+
+        const vk::Buffer buffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(instancesData));
+
+        return InstancesData{ buffer };
+    }
+
+    static ImageInfo GetTexturesDescriptorInfo(const tinygltf::Model& model,
+            const std::vector<Texture>& textures, const std::vector<vk::Sampler>& samplers)
+    {
         ImageInfo descriptorInfo;
         descriptorInfo.reserve(model.textures.size());
 
@@ -966,208 +1352,121 @@ namespace DetailsRT
                     Renderer::blackTexture.view, vk::ImageLayout::eShaderReadOnlyOptimal);
         }
 
-        return TexturesData{ textures, samplers, descriptorInfo };
+        return descriptorInfo;
     }
 
-    static std::vector<glm::vec3> CalculateNormals(const DataView<uint32_t>& indices,
-            const DataView<glm::vec3>& positions)
+    static TexturesData CreateTexturesData(const tinygltf::Model& model, const std::vector<Texture>& textures)
     {
-        std::vector<glm::vec3> normals(positions.size);
+        const std::vector<vk::Sampler> samplers = Details::CreateSamplers(model);
 
-        for (size_t i = 0; i < indices.size; i = i + 3)
-        {
-            const glm::vec3& position0 = positions.data[indices.data[i]];
-            const glm::vec3& position1 = positions.data[indices.data[i + 1]];
-            const glm::vec3& position2 = positions.data[indices.data[i + 2]];
+        return TexturesData{ textures, samplers, GetTexturesDescriptorInfo(model, textures, samplers) };
+    }
 
-            const glm::vec3 edge1 = position1 - position0;
-            const glm::vec3 edge2 = position2 - position0;
+    static void UpdateTexturesDescriptor(const DescriptorSet& descriptorSet, const ImageInfo& descriptorInfo)
+    {
+        const DescriptorData descriptorData{ vk::DescriptorType::eCombinedImageSampler, descriptorInfo };
 
-            const glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+        VulkanContext::descriptorPool->UpdateDescriptorSet(descriptorSet.value, { descriptorData }, kTexturesBinding);
+    }
 
-            normals[indices.data[i]] += normal;
-            normals[indices.data[i + 1]] += normal;
-            normals[indices.data[i + 2]] += normal;
-        }
+    static PrimitiveGeometry SplitVertices(const std::vector<Details::Vertex>& vertices)
+    {
+        PrimitiveGeometry primitiveGeometry;
+        primitiveGeometry.positions.reserve(vertices.size());
+        primitiveGeometry.normals.reserve(vertices.size());
+        primitiveGeometry.tangents.reserve(vertices.size());
+        primitiveGeometry.texCoords.reserve(vertices.size());
 
-        for (auto& normal : normals)
+        for (const auto& vertex : vertices)
         {
-            normal = glm::normalize(normal);
+            primitiveGeometry.positions.push_back(vertex.position);
+            primitiveGeometry.normals.push_back(vertex.normal);
+            primitiveGeometry.tangents.push_back(vertex.tangent);
+            primitiveGeometry.texCoords.push_back(vertex.texCoord);
         }
 
-        return normals;
+        return primitiveGeometry;
     }
 
-    static std::vector<glm::vec3> CalculateTangents(const DataView<uint32_t>& indices,
-            const DataView<glm::vec3>& positions, const DataView<glm::vec2>& texCoords)
+    static ByteView GetAttributeData(const SceneCache::PrimitiveData& primitive, GeometryAttribute attribute)
     {
-        std::vector<glm::vec3> tangents(positions.size);
-
-        for (size_t i = 0; i < indices.size; i = i + 3)
-        {
-            const glm::vec3& position0 = positions.data[indices.data[i]];
-            const glm::vec3& position1 = positions.data[indices.data[i + 1]];
-            const glm::vec3& position2 = positions.data[indices.data[i + 2]];
-
-            const glm::vec3 edge1 = position1 - position0;
-            const glm::vec3 edge2 = position2 - position0;
-
-            const glm::vec2& texCoord0 = texCoords.data[indices.data[i]];
-            const glm::vec2& texCoord1 = texCoords.data[indices.data[i + 1]];
-            const glm::vec2& texCoord2 = texCoords.data[indices.data[i + 2]];
-
-            const glm::vec2 deltaTexCoord1 = texCoord1 - texCoord0;
-            const glm::vec2 deltaTexCoord2 = texCoord2 - texCoord0;
-
-            float d = deltaTexCoord1.x * deltaTexCoord2.y - deltaTexCoord1.y * deltaTexCoord2.x;
-
-            if (d == 0.0f)
-            {
-                d = 1.0f;
-            }
-
-            const glm::vec3 tangent = (edge1 * deltaTexCoord2.y - edge2 * deltaTexCoord1.y) / d;
-
-            tangents[indices.data[i]] += tangent;
-            tangents[indices.data[i + 1]] += tangent;
-            tangents[indices.data[i + 2]] += tangent;
-        }
-
-        for (auto& tangent : tangents)
+        switch (attribute)
         {
-            if (glm::length(tangent) > 0.0f)
-            {
-                tangent = glm::normalize(tangent);
-            }
-            else
-            {
-                tangent.x = 1.0f;
-            }
+        case GeometryAttribute::ePositions:
+            return primitive.positions;
+        case GeometryAttribute::eIndices:
+            return Details::GetBaseIndices(primitive);
+        case GeometryAttribute::eNormals:
+            return primitive.normals;
+        case GeometryAttribute::eTangents:
+            return primitive.tangents;
+        case GeometryAttribute::eTexCoords:
+            return primitive.texCoords;
+        default:
+            Assert(false);
+            return ByteView();
         }
-
-        return tangents;
     }
 
-    static void AppendPrimitiveGeometry(const tinygltf::Model& model, const tinygltf::Primitive& primitive,
-            const std::vector<GeometryAttribute>& attributes, GeometryData& geometryData)
+    // All primitives are packed into one buffer per attribute, instances address them with base offsets
+    static GeometryData CreateGeometryData(const std::vector<SceneCache::PrimitiveData>& primitives,
+            const std::vector<GeometryAttribute>& attributes)
     {
-        Assert(primitive.mode == TINYGLTF_MODE_TRIANGLES);
-        Assert(primitive.indices >= 0);
-
-        const tinygltf::Accessor& indicesAccessor = model.accessors[primitive.indices];
+        std::vector<Bytes> attributesData(attributes.size());
 
-        DataView<uint32_t> indicesData = Helpers::GetAccessorDataView<uint32_t>(model, indicesAccessor);
-        std::vector<uint32_t> indices;
-        if (indicesAccessor.componentType != TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
+        for (size_t i = 0; i < attributes.size(); ++i)
         {
-            Assert(indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT);
-
-            indices.resize(indicesAccessor.count);
-
-            for (size_t i = 0; i < indicesAccessor.count; ++i)
+            for (const auto& primitive : primitives)
             {
-                indices[i] = reinterpret_cast<const uint16_t*>(indicesData.data)[i];
-            }
+                const ByteView attributeData = GetAttributeData(primitive, attributes[i]);
 
-            indicesData = DataView(indices);
+                attributesData[i].insert(attributesData[i].end(),
+                        attributeData.data, attributeData.data + attributeData.size);
+            }
         }
 
-        const tinygltf::Accessor& positionsAccessor = model.accessors[primitive.attributes.at("POSITION")];
-        const DataView<glm::vec3> positionsData = Helpers::GetAccessorDataView<glm::vec3>(model, positionsAccessor);
+        std::vector<BufferHelpers::BufferData> buffersData;
+        buffersData.reserve(attributes.size());
 
-        std::vector<glm::vec2> texCoords;
-        DataView<glm::vec2> texCoordsData;
-        if (Contains(attributes, GeometryAttribute::eTexCoords))
+        for (size_t i = 0; i < attributes.size(); ++i)
         {
-            if (primitive.attributes.count("TEXCOORD_0") > 0)
-            {
-                const tinygltf::Accessor& texCoordsAccessor = model.accessors[primitive.attributes.at("TEXCOORD_0")];
-                texCoordsData = Helpers::GetAccessorDataView<glm::vec2>(model, texCoordsAccessor);
-            }
-            else
-            {
-                texCoords = std::vector<glm::vec2>(positionsData.size);
-                texCoordsData = DataView(texCoords);
-            }
-        }
+            vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eStorageBuffer;
 
-        std::vector<glm::vec3> normals;
-        DataView<glm::vec3> normalsData;
-        if (Contains(attributes, GeometryAttribute::eNormals))
-        {
-            if (primitive.attributes.count("NORMAL") > 0)
-            {
-                const tinygltf::Accessor& normalsAccessor = model.accessors[primitive.attributes.at("NORMAL")];
-                normalsData = Helpers::GetAccessorDataView<glm::vec3>(model, normalsAccessor);
-            }
-            else
+            if (attributes[i] == GeometryAttribute::ePositions || attributes[i] == GeometryAttribute::eIndices)
             {
-                normals = CalculateNormals(indicesData, positionsData);
-                normalsData = DataView(normals);
+                usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress
+                        | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
             }
-        }
 
-        std::vector<glm::vec3> tangents;
-        DataView<glm::vec3> tangentsData;
-        if (Contains(attributes, GeometryAttribute::eTangents))
-        {
-            if (primitive.attributes.count("TANGENT") > 0)
-            {
-                const tinygltf::Accessor& tangentsAccessor = model.accessors[primitive.attributes.at("NORMAL")];
-                tangentsData = Helpers::GetAccessorDataView<glm::vec3>(model, tangentsAccessor);
-            }
-            else
-            {
-                tangents = CalculateTangents(indicesData, positionsData, texCoordsData);
-                tangentsData = DataView(tangents);
-            }
+            buffersData.emplace_back(usage, ByteView(attributesData[i]));
         }
 
-        const std::map<GeometryAttribute, ByteView> data{
-            { GeometryAttribute::eIndices, ByteView(indicesData) },
-            { GeometryAttribute::eNormals, ByteView(normalsData) },
-            { GeometryAttribute::eTangents, ByteView(tangentsData) },
-            { GeometryAttribute::eTexCoords, ByteView(texCoordsData) }
-        };
-
-        for (const auto& attribute : attributes)
-        {
-            const vk::Buffer buffer = BufferHelpers::CreateBufferWithData(
-                    vk::BufferUsageFlagBits::eStorageBuffer, data.at(attribute));
+        const std::vector<vk::Buffer> buffers = BufferHelpers::CreateBuffersWithData(buffersData);
 
-            geometryData.buffers.push_back(buffer);
+        GeometryData geometryData;
 
-            geometryData.descriptorsInfo[attribute].emplace_back(buffer, 0, VK_WHOLE_SIZE);
+        for (size_t i = 0; i < attributes.size(); ++i)
+        {
+            geometryData.buffers.emplace(attributes[i], buffers[i]);
         }
+
+        return geometryData;
     }
 
-    static GeometryData CreateGeometryData(const tinygltf::Model& model,
-            const std::vector<GeometryAttribute>& attributes)
+    static void DestroyGeometryBuffer(GeometryData& geometryData, GeometryAttribute attribute)
     {
-        GeometryData geometryData;
-
-        Details::EnumerateNodes(model, [&](int32_t nodeIndex, const glm::mat4&)
-            {
-                const tinygltf::Node& node = model.nodes[nodeIndex];
-
-                if (node.mesh >= 0)
-                {
-                    const tinygltf::Mesh& mesh = model.meshes[node.mesh];
+        const auto it = geometryData.buffers.find(attribute);
+        Assert(it != geometryData.buffers.end());
 
-                    for (const auto& primitive : mesh.primitives)
-                    {
-                        AppendPrimitiveGeometry(model, primitive, attributes, geometryData);
-                    }
-                }
-            });
+        VulkanContext::bufferManager->DestroyBuffer(it->second);
 
-        return geometryData;
+        geometryData.buffers.erase(it);
     }
 
     static DescriptorSet CreateDescriptorSet(const RayTracingData& rayTracingData,
-            vk::ShaderStageFlags forcedShaderStages)
+            const std::vector<GeometryAttribute>& geometryAttributes, vk::ShaderStageFlags forcedShaderStages)
     {
-        const auto& [accelerationData, materialsData, texturesData, geometryData] = rayTracingData;
+        const auto& [accelerationData, materialsData, instancesData, texturesData, geometryData] = rayTracingData;
 
         const bool forceShaderStages = forcedShaderStages != vk::ShaderStageFlags();
 
@@ -1177,6 +1476,10 @@ namespace DetailsRT
         const vk::ShaderStageFlags materialsShaderStages = forceShaderStages
                 ? forcedShaderStages : (vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eAnyHitKHR);
 
+        const vk::ShaderStageFlags instancesShaderStages = forceShaderStages ? forcedShaderStages
+                : (vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eAnyHitKHR
+                        | vk::ShaderStageFlagBits::eClosestHitKHR);
+
         const vk::ShaderStageFlags texturesShaderStages = forceShaderStages
                 ? forcedShaderStages : (vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eAnyHitKHR);
 
@@ -1187,10 +1490,15 @@ namespace DetailsRT
                 vk::DescriptorBindingFlags()
             },
             DescriptorDescription{
-                1, vk::DescriptorType::eUniformBuffer,
+                1, vk::DescriptorType::eStorageBuffer,
                 materialsShaderStages,
                 vk::DescriptorBindingFlags()
             },
+            DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                instancesShaderStages,
+                vk::DescriptorBindingFlags()
+            },
             DescriptorDescription{
                 static_cast<uint32_t>(texturesData.descriptorInfo.size()),
                 vk::DescriptorType::eCombinedImageSampler,
@@ -1201,12 +1509,18 @@ namespace DetailsRT
 
         DescriptorSetData descriptorSetData{
             DescriptorHelpers::GetData(accelerationData.tlas),
-            DescriptorHelpers::GetData(materialsData.buffer),
+            GetStorageBufferData(materialsData.buffer),
+            GetStorageBufferData(instancesData.buffer),
             DescriptorData{ vk::DescriptorType::eCombinedImageSampler, texturesData.descriptorInfo }
         };
 
-        for (const auto& [geometryAttribute, descriptorInfo] : geometryData.descriptorsInfo)
+        for (const auto& [geometryAttribute, buffer] : geometryData.buffers)
         {
+            if (!Contains(geometryAttributes, geometryAttribute))
+            {
+                continue;
+            }
+
             vk::ShaderStageFlags geometryShaderStages = forceShaderStages
                     ? forcedShaderStages : vk::ShaderStageFlagBits::eClosestHitKHR;
 
@@ -1225,18 +1539,13 @@ namespace DetailsRT
             }
 
             const DescriptorDescription descriptorDescription{
-                static_cast<uint32_t>(descriptorInfo.size()),
-                vk::DescriptorType::eStorageBuffer,
+                1, vk::DescriptorType::eStorageBuffer,
                 geometryShaderStages,
-                vk::DescriptorBindingFlagBits::eVariableDescriptorCount
-            };
-
-            const DescriptorData descriptorData{
-                vk::DescriptorType::eStorageBuffer, descriptorInfo
+                vk::DescriptorBindingFlags()
             };
 
             descriptorSetDescription.push_back(descriptorDescription);
-            descriptorSetData.push_back(descriptorData);
+            descriptorSetData.push_back(GetStorageBufferData(buffer));
         }
 
         return DescriptorHelpers::CreateDescriptorSet(descriptorSetDescription, descriptorSetData);
@@ -1250,8 +1559,14 @@ namespace DetailsPT
         DetailsRT::AccelerationData accelerationData;
         vk::Buffer pointLightsBuffer;
         vk::Buffer colorsBuffer;
+        vk::Buffer lightTreeBuffer;
     };
 
+    static float GetLightPower(const PointLight& pointLight)
+    {
+        return glm::dot(glm::vec3(pointLight.color), glm::vec3(0.2126f, 0.7152f, 0.0722f));
+    }
+
     static constexpr vk::ShaderStageFlags GetShaderStages()
     {
         if constexpr (Config::kPathTracingMode == Config::PathTracingMode::eRayTracing)
@@ -1294,24 +1609,98 @@ namespace DetailsPT
         return DetailsRT::AccelerationData{ tlas, { boundingBoxBlas } };
     }
 
-    static PointLightsData CreatePointLightsData(const std::vector<PointLight>& pointLights)
+    // Splits lights at the median of the widest axis, so the tree depth is logarithmic in light count
+    static void BuildLightTreeNode(const std::vector<PointLight>& pointLights, std::vector<uint32_t>& lightIndices,
+            size_t first, size_t last, uint32_t nodeIndex, std::vector<LightTreeNode>& nodes)
     {
-        const vk::Buffer pointLightsBuffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eUniformBuffer, ByteView(pointLights));
+        glm::vec3 minPosition(std::numeric_limits<float>::max());
+        glm::vec3 maxPosition(std::numeric_limits<float>::lowest());
 
-        std::vector<glm::vec4> pointLightsColors(pointLights.size());
-        for (size_t i = 0; i < pointLights.size(); ++i)
+        float power = 0.0f;
+
+        for (size_t i = first; i < last; ++i)
         {
-            pointLightsColors[i] = pointLights[i].color;
+            const PointLight& pointLight = pointLights[lightIndices[i]];
+
+            minPosition = glm::min(minPosition, glm::vec3(pointLight.position));
+            maxPosition = glm::max(maxPosition, glm::vec3(pointLight.position));
+
+            power += GetLightPower(pointLight);
         }
 
-        const vk::Buffer colorsBuffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eUniformBuffer, ByteView(pointLightsColors));
+        nodes[nodeIndex].boundsMin = minPosition;
+        nodes[nodeIndex].boundsMax = maxPosition;
+        nodes[nodeIndex].power = power;
 
-        const PointLightsData pointLightsData{
-            CreateAccelerationData(pointLights),
+        if (last - first == 1)
+        {
+            nodes[nodeIndex].index = lightIndices[first] | LIGHT_TREE_LEAF_BIT;
+            return;
+        }
+
+        const glm::vec3 extent = maxPosition - minPosition;
+
+        glm::length_t axis = extent.x > extent.y ? 0 : 1;
+        if (extent.z > extent[axis])
+        {
+            axis = 2;
+        }
+
+        const size_t middle = first + (last - first) / 2;
+
+        std::nth_element(lightIndices.begin() + first, lightIndices.begin() + middle, lightIndices.begin() + last,
+                [&](uint32_t a, uint32_t b)
+                {
+                    return pointLights[a].position[axis] < pointLights[b].position[axis];
+                });
+
+        const uint32_t leftIndex = static_cast<uint32_t>(nodes.size());
+
+        nodes.resize(nodes.size() + 2);
+
+        nodes[nodeIndex].index = leftIndex;
+
+        BuildLightTreeNode(pointLights, lightIndices, first, middle, leftIndex, nodes);
+        BuildLightTreeNode(pointLights, lightIndices, middle, last, leftIndex + 1, nodes);
+    }
+
+    static std::vector<LightTreeNode> CreateLightTree(const std::vector<PointLight>& pointLights)
+    {
+        Assert(!pointLights.empty());
+
+        std::vector<uint32_t> lightIndices(pointLights.size());
+        std::iota(lightIndices.begin(), lightIndices.end(), 0);
+
+        std::vector<LightTreeNode> nodes(1);
+        nodes.reserve(pointLights.size() * 2 - 1);
+
+        BuildLightTreeNode(pointLights, lightIndices, 0, pointLights.size(), 0, nodes);
+
+        return nodes;
+    }
+
+    static PointLightsData CreatePointLightsData(const std::vector<PointLight>& pointLights)
+    {
+        const vk::Buffer pointLightsBuffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(pointLights));
+
+        std::vector<glm::vec4> pointLightsColors(pointLights.size());
+        for (size_t i = 0; i < pointLights.size(); ++i)
+        {
+            pointLightsColors[i] = pointLights[i].color;
+        }
+
+        const vk::Buffer colorsBuffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(pointLightsColors));
+
+        const vk::Buffer lightTreeBuffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(CreateLightTree(pointLights)));
+
+        const PointLightsData pointLightsData{
+            CreateAccelerationData(pointLights),
             pointLightsBuffer,
-            colorsBuffer
+            colorsBuffer,
+            lightTreeBuffer
         };
 
         return pointLightsData;
@@ -1331,6 +1720,9 @@ namespace DetailsPT
         const vk::ShaderStageFlags colorsShaderStages = forceShaderStages
                 ? forcedShaderStages : vk::ShaderStageFlagBits::eClosestHitKHR;
 
+        const vk::ShaderStageFlags lightTreeShaderStages = forceShaderStages
+                ? forcedShaderStages : vk::ShaderStageFlagBits::eRaygenKHR;
+
         const DescriptorSetDescription descriptorSetDescription{
             DescriptorDescription{
                 1, vk::DescriptorType::eAccelerationStructureKHR,
@@ -1338,86 +1730,881 @@ namespace DetailsPT
                 vk::DescriptorBindingFlags()
             },
             DescriptorDescription{
-                1, vk::DescriptorType::eUniformBuffer,
+                1, vk::DescriptorType::eStorageBuffer,
                 pointLightsShaderStages,
                 vk::DescriptorBindingFlags()
             },
             DescriptorDescription{
-                1, vk::DescriptorType::eUniformBuffer,
+                1, vk::DescriptorType::eStorageBuffer,
                 colorsShaderStages,
                 vk::DescriptorBindingFlags()
+            },
+            DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                lightTreeShaderStages,
+                vk::DescriptorBindingFlags()
             }
         };
 
         const DescriptorSetData descriptorSetData{
             DescriptorHelpers::GetData(pointLightsData.accelerationData.tlas),
-            DescriptorHelpers::GetData(pointLightsData.pointLightsBuffer),
-            DescriptorHelpers::GetData(pointLightsData.colorsBuffer)
+            DetailsRT::GetStorageBufferData(pointLightsData.pointLightsBuffer),
+            DetailsRT::GetStorageBufferData(pointLightsData.colorsBuffer),
+            DetailsRT::GetStorageBufferData(pointLightsData.lightTreeBuffer)
         };
 
         return DescriptorHelpers::CreateDescriptorSet(descriptorSetDescription, descriptorSetData);
     }
 }
 
+namespace DetailsCache
+{
+    using MipLevels = std::vector<Bytes>;
+
+    struct CompressedTexture
+    {
+        vk::Format format;
+        MipLevels mipLevels;
+    };
+
+    static void ProcessLoadingResult(bool result, const std::string& errors, const std::string& warnings)
+    {
+        if (!warnings.empty())
+        {
+            LogW << "Scene loaded with warnings:\n" << warnings;
+        }
+
+        if (!errors.empty())
+        {
+            LogE << "Failed to load scene:\n" << errors;
+        }
+
+        Assert(result);
+    }
+
+    constexpr uint32_t kGlbMagic = 0x46546C67;
+    constexpr uint32_t kGlbVersion = 2;
+    constexpr uint32_t kGlbJsonChunk = 0x4E4F534A;
+    constexpr uint32_t kGlbBinaryChunk = 0x004E4942;
+
+    constexpr std::string_view kPlaceholderUri = "data:application/octet-stream;base64,AA==";
+
+    struct ModelSource
+    {
+        std::vector<std::unique_ptr<MappedFile>> files;
+        Helpers::ModelBuffers buffers;
+    };
+
+    static const ByteView& MapFile(ModelSource& source, const Filepath& path)
+    {
+        std::unique_ptr<MappedFile> file = MappedFile::Create(path);
+        Assert(file);
+
+        return source.files.emplace_back(std::move(file))->GetData();
+    }
+
+    struct GlbChunks
+    {
+        ByteView json;
+        ByteView binary;
+    };
+
+    static GlbChunks ParseGlb(const ByteView& data)
+    {
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t length;
+        };
+
+        struct ChunkHeader
+        {
+            uint32_t length;
+            uint32_t type;
+        };
+
+        Assert(data.size >= sizeof(Header));
+
+        const Header header = *reinterpret_cast<const Header*>(data.data);
+
+        Assert(header.magic == kGlbMagic);
+        Assert(header.version == kGlbVersion);
+        Assert(header.length <= data.size);
+
+        GlbChunks chunks;
+
+        size_t offset = sizeof(Header);
+        while (offset + sizeof(ChunkHeader) <= header.length)
+        {
+            const ChunkHeader chunkHeader = *reinterpret_cast<const ChunkHeader*>(data.data + offset);
+
+            offset += sizeof(ChunkHeader);
+
+            Assert(offset + chunkHeader.length <= header.length);
+
+            const ByteView chunk(data.data + offset, chunkHeader.length);
+
+            if (chunkHeader.type == kGlbJsonChunk && chunks.json.size == 0)
+            {
+                chunks.json = chunk;
+            }
+            else if (chunkHeader.type == kGlbBinaryChunk && chunks.binary.size == 0)
+            {
+                chunks.binary = chunk;
+            }
+
+            offset += chunkHeader.length;
+        }
+
+        Assert(chunks.json.size > 0);
+
+        return chunks;
+    }
+
+    struct ImageSource
+    {
+        int32_t bufferView = -1;
+        std::string uri;
+        ByteView data;
+        Bytes embedded;
+    };
+
+    static bool LoadImageDataCallback(tinygltf::Image*, int32_t imageIndex, std::string*,
+            std::string*, int32_t, int32_t, const uint8_t* bytes, int32_t size, void* userData)
+    {
+        ImageSource& imageSource = (*static_cast<std::vector<ImageSource>*>(userData))[imageIndex];
+
+        if (imageSource.bufferView < 0 && imageSource.data.size == 0)
+        {
+            imageSource.embedded.assign(bytes, bytes + size);
+        }
+
+        return true;
+    }
+
+    static std::vector<ImageSource> DeferImages(nlohmann::json& document,
+            const Filepath& path, ModelSource& source)
+    {
+        if (!document.contains("images"))
+        {
+            return {};
+        }
+
+        nlohmann::json& images = document["images"];
+
+        std::vector<ImageSource> imageSources(images.size());
+
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            nlohmann::json& image = images[i];
+
+            if (image.contains("bufferView"))
+            {
+                imageSources[i].bufferView = image["bufferView"].get<int32_t>();
+
+                image.erase("bufferView");
+                image["uri"] = kPlaceholderUri;
+            }
+            else if (image.contains("uri"))
+            {
+                const std::string uri = image["uri"].get<std::string>();
+
+                if (!uri.starts_with("data:"))
+                {
+                    const Filepath imagePath(path.GetDirectory() + uri);
+
+                    imageSources[i].uri = uri;
+                    imageSources[i].data = MapFile(source, imagePath);
+
+                    image["uri"] = kPlaceholderUri;
+                }
+            }
+        }
+
+        return imageSources;
+    }
+
+    static void DecodeImages(tinygltf::Model& model, const Helpers::ModelBuffers& buffers,
+            std::vector<ImageSource>& imageSources)
+    {
+        const Stopwatch stopwatch;
+
+        for (size_t i = 0; i < imageSources.size(); ++i)
+        {
+            ImageSource& imageSource = imageSources[i];
+            tinygltf::Image& image = model.images[i];
+
+            if (imageSource.bufferView >= 0)
+            {
+                const tinygltf::BufferView& bufferView = model.bufferViews[imageSource.bufferView];
+                const ByteView& buffer = buffers[bufferView.buffer];
+
+                Assert(bufferView.byteOffset + bufferView.byteLength <= buffer.size);
+
+                imageSource.data = ByteView(buffer.data + bufferView.byteOffset, bufferView.byteLength);
+            }
+            else if (!imageSource.embedded.empty())
+            {
+                imageSource.data = ByteView(imageSource.embedded);
+            }
+
+            image.bufferView = imageSource.bufferView;
+            image.uri = imageSource.uri;
+        }
+
+        const uint32_t threadCount = ThreadHelpers::GetThreadCount();
+
+        std::vector<std::string> errors(imageSources.size());
+        std::vector<std::string> warnings(imageSources.size());
+        std::vector<uint8_t> results(imageSources.size());
+
+        ThreadHelpers::ParallelFor(imageSources.size(), threadCount, [&](size_t i)
+            {
+                const ByteView& data = imageSources[i].data;
+
+                results[i] = tinygltf::LoadImageData(&model.images[i], static_cast<int32_t>(i),
+                        &errors[i], &warnings[i], 0, 0, data.data, static_cast<int32_t>(data.size), nullptr);
+            });
+
+        const double decodeTime = stopwatch.GetElapsedMiliseconds();
+
+        size_t encodedSize = 0;
+        size_t decodedSize = 0;
+
+        for (size_t i = 0; i < imageSources.size(); ++i)
+        {
+            ProcessLoadingResult(results[i], errors[i], warnings[i]);
+
+            encodedSize += imageSources[i].data.size;
+            decodedSize += model.images[i].image.size();
+        }
+
+        const float encodedMegabytes = static_cast<float>(encodedSize) / static_cast<float>(Numbers::kMegabyte);
+        const float decodedMegabytes = static_cast<float>(decodedSize) / static_cast<float>(Numbers::kMegabyte);
+        const double decodeSeconds = std::max(decodeTime * Numbers::kMili, static_cast<double>(Numbers::kMicro));
+        const double throughput = decodedMegabytes / decodeSeconds;
+
+        LogI << Format("Scene textures decoded: %zu images, %.2f MB -> %.2f MB in %.2f ms (%.2f MB/s, %u threads)",
+                imageSources.size(), encodedMegabytes, decodedMegabytes, decodeTime,
+                throughput, threadCount) << "\n";
+    }
+
+    static ModelSource LoadModel(tinygltf::Model& model, const Filepath& path)
+    {
+        ModelSource source;
+
+        const ByteView& fileData = MapFile(source, path);
+
+        GlbChunks chunks{ fileData, ByteView() };
+        if (path.GetExtension() == ".glb")
+        {
+            chunks = ParseGlb(fileData);
+        }
+
+        nlohmann::json document = nlohmann::json::parse(chunks.json.data, chunks.json.data + chunks.json.size);
+
+        std::vector<bool> mappedBuffers;
+
+        if (document.contains("buffers"))
+        {
+            nlohmann::json& buffers = document["buffers"];
+
+            source.buffers.resize(buffers.size());
+            mappedBuffers.resize(buffers.size(), true);
+
+            for (size_t i = 0; i < buffers.size(); ++i)
+            {
+                nlohmann::json& buffer = buffers[i];
+
+                if (!buffer.contains("uri"))
+                {
+                    source.buffers[i] = chunks.binary;
+                }
+                else
+                {
+                    const std::string uri = buffer["uri"].get<std::string>();
+
+                    if (uri.starts_with("data:"))
+                    {
+                        mappedBuffers[i] = false;
+                        continue;
+                    }
+
+                    const Filepath bufferPath(path.GetDirectory() + uri);
+
+                    source.buffers[i] = MapFile(source, bufferPath);
+                }
+
+                Assert(buffer["byteLength"].get<size_t>() <= source.buffers[i].size);
+
+                buffer["uri"] = kPlaceholderUri;
+                buffer["byteLength"] = 1;
+            }
+        }
+
+        std::vector<ImageSource> imageSources = DeferImages(document, path, source);
+
+        const std::string json = document.dump();
+
+        tinygltf::TinyGLTF loader;
+        loader.SetImageLoader(&LoadImageDataCallback, &imageSources);
+
+        std::string errors;
+        std::string warnings;
+
+        const bool result = loader.LoadASCIIFromString(&model, &errors, &warnings,
+                json.data(), static_cast<uint32_t>(json.size()), path.GetDirectory());
+
+        ProcessLoadingResult(result, errors, warnings);
+
+        size_t mappedSize = 0;
+
+        for (size_t i = 0; i < source.buffers.size(); ++i)
+        {
+            if (mappedBuffers[i])
+            {
+                mappedSize += source.buffers[i].size;
+            }
+            else
+            {
+                source.buffers[i] = ByteView(model.buffers[i].data);
+            }
+        }
+
+        DecodeImages(model, source.buffers, imageSources);
+
+        LogI << Format("Scene buffers mapped without copy: %.2f MB",
+                static_cast<float>(mappedSize) / static_cast<float>(Numbers::kMegabyte)) << "\n";
+
+        return source;
+    }
+
+    static void LoadModel(tinygltf::Model& model, const ByteView& json, const Filepath& path)
+    {
+        tinygltf::TinyGLTF loader;
+        std::string errors;
+        std::string warnings;
+
+        const bool result = loader.LoadASCIIFromString(&model, &errors, &warnings,
+                reinterpret_cast<const char*>(json.data), static_cast<uint32_t>(json.size), path.GetDirectory());
+
+        ProcessLoadingResult(result, errors, warnings);
+    }
+
+    static void LogVertexCompression(const std::vector<Details::MeshData>& meshesData,
+            const std::vector<Details::PackedMeshData>& packedMeshesData)
+    {
+        size_t originalSize = 0;
+        size_t packedSize = 0;
+
+        for (size_t i = 0; i < meshesData.size(); ++i)
+        {
+            originalSize += meshesData[i].vertices.size() * sizeof(Details::Vertex)
+                    + meshesData[i].indices.size() * sizeof(uint32_t);
+
+            packedSize += packedMeshesData[i].vertices.size() * sizeof(Scene::Mesh::Vertex);
+
+            if (packedMeshesData[i].compactIndices.empty())
+            {
+                packedSize += meshesData[i].indices.size() * sizeof(uint32_t);
+            }
+            else
+            {
+                packedSize += packedMeshesData[i].compactIndices.size() * sizeof(uint16_t);
+            }
+        }
+
+        LogI << Format("Raster geometry compression: %.2f MB -> %.2f MB",
+                static_cast<float>(originalSize) / static_cast<float>(Numbers::kMegabyte),
+                static_cast<float>(packedSize) / static_cast<float>(Numbers::kMegabyte)) << "\n";
+    }
+
+    static std::vector<SceneCache::PrimitiveData> DecodePrimitives(const tinygltf::Model& model,
+            const Helpers::ModelBuffers& buffers, uint32_t threadCount, std::vector<Details::MeshData>& meshesData,
+            std::vector<Details::PackedMeshData>& packedMeshesData,
+            std::vector<DetailsRT::PrimitiveGeometry>& primitivesGeometry)
+    {
+        meshesData = Details::DecodeMeshes(model, buffers, threadCount);
+
+        packedMeshesData.resize(meshesData.size());
+        primitivesGeometry.resize(meshesData.size());
+
+        ThreadHelpers::ParallelFor(meshesData.size(), threadCount, [&](size_t i)
+            {
+                packedMeshesData[i] = Details::PackMesh(meshesData[i]);
+                primitivesGeometry[i] = DetailsRT::SplitVertices(meshesData[i].vertices);
+            });
+
+        LogVertexCompression(meshesData, packedMeshesData);
+
+        std::vector<SceneCache::PrimitiveData> primitives;
+        primitives.reserve(meshesData.size());
+
+        for (size_t i = 0; i < meshesData.size(); ++i)
+        {
+            meshesData[i].vertices = {};
+
+            primitives.push_back(SceneCache::PrimitiveData{
+                ByteView(packedMeshesData[i].vertices),
+                ByteView(meshesData[i].indices),
+                ByteView(packedMeshesData[i].compactIndices),
+                ByteView(primitivesGeometry[i].positions),
+                ByteView(primitivesGeometry[i].normals),
+                ByteView(primitivesGeometry[i].tangents),
+                ByteView(primitivesGeometry[i].texCoords),
+                ByteView(meshesData[i].meshlets),
+                ByteView(meshesData[i].lods),
+                packedMeshesData[i].positionOffset,
+                packedMeshesData[i].positionScale
+            });
+        }
+
+        return primitives;
+    }
+
+    static Bytes GenerateMipLevel(const ByteView& data, const vk::Extent2D& extent,
+            const vk::Extent2D& mipLevelExtent, uint32_t componentCount)
+    {
+        Bytes mipLevel(static_cast<size_t>(mipLevelExtent.width) * mipLevelExtent.height * componentCount);
+
+        const auto getTexel = [&](uint32_t x, uint32_t y, uint32_t c)
+            {
+                x = std::min(x, extent.width - 1);
+                y = std::min(y, extent.height - 1);
+
+                return static_cast<uint32_t>(data.data[(static_cast<size_t>(y) * extent.width + x) * componentCount + c]);
+            };
+
+        for (uint32_t y = 0; y < mipLevelExtent.height; ++y)
+        {
+            for (uint32_t x = 0; x < mipLevelExtent.width; ++x)
+            {
+                for (uint32_t c = 0; c < componentCount; ++c)
+                {
+                    const uint32_t sum = getTexel(x * 2, y * 2, c) + getTexel(x * 2 + 1, y * 2, c)
+                            + getTexel(x * 2, y * 2 + 1, c) + getTexel(x * 2 + 1, y * 2 + 1, c);
+
+                    const size_t index = (static_cast<size_t>(y) * mipLevelExtent.width + x) * componentCount + c;
+
+                    mipLevel[index] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        return mipLevel;
+    }
+
+    static std::vector<MipLevels> GenerateMipLevels(const tinygltf::Model& model, uint32_t threadCount)
+    {
+        std::vector<MipLevels> mipLevels(model.images.size());
+
+        ThreadHelpers::ParallelFor(model.images.size(), threadCount, [&](size_t i)
+            {
+                const tinygltf::Image& image = model.images[i];
+
+                const vk::Extent2D extent = VulkanHelpers::GetExtent(image.width, image.height);
+                const uint32_t mipLevelCount = ImageHelpers::CalculateMipLevelCount(extent);
+                const uint32_t componentCount = static_cast<uint32_t>(image.component);
+
+                mipLevels[i].reserve(mipLevelCount - 1);
+
+                ByteView data(image.image);
+                vk::Extent2D dataExtent = extent;
+
+                for (uint32_t j = 1; j < mipLevelCount; ++j)
+                {
+                    const vk::Extent2D mipLevelExtent = ImageHelpers::CalculateMipLevelExtent(extent, j);
+
+                    mipLevels[i].push_back(GenerateMipLevel(data, dataExtent, mipLevelExtent, componentCount));
+
+                    data = ByteView(mipLevels[i].back());
+                    dataExtent = mipLevelExtent;
+                }
+            });
+
+        return mipLevels;
+    }
+
+    static std::vector<SceneCache::TextureData> GetTexturesData(const tinygltf::Model& model,
+            const std::vector<MipLevels>& mipLevels)
+    {
+        std::vector<SceneCache::TextureData> texturesData;
+        texturesData.reserve(model.images.size());
+
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            const tinygltf::Image& image = model.images[i];
+
+            SceneCache::TextureData textureData{
+                Helpers::GetFormat(image),
+                VulkanHelpers::GetExtent(image.width, image.height),
+                { ByteView(image.image) }
+            };
+
+            if (i < mipLevels.size())
+            {
+                for (const auto& mipLevel : mipLevels[i])
+                {
+                    textureData.mipLevels.emplace_back(mipLevel);
+                }
+            }
+
+            texturesData.push_back(textureData);
+        }
+
+        return texturesData;
+    }
+
+    static vk::Format GetCompressedFormat(const tinygltf::Image& image, bool isNormalMap)
+    {
+        if (isNormalMap)
+        {
+            return vk::Format::eBc5UnormBlock;
+        }
+
+        if constexpr (Config::kTextureCompression == Config::TextureCompression::eBC7)
+        {
+            return vk::Format::eBc7UnormBlock;
+        }
+
+        if (TextureCompression::HasTransparency(ByteView(image.image), static_cast<uint32_t>(image.component)))
+        {
+            return vk::Format::eBc3UnormBlock;
+        }
+
+        return vk::Format::eBc1RgbUnormBlock;
+    }
+
+    static std::vector<CompressedTexture> CompressTextures(const tinygltf::Model& model,
+            const std::vector<MipLevels>& mipLevels, uint32_t threadCount)
+    {
+        const Stopwatch stopwatch;
+
+        std::vector<bool> normalMaps(model.images.size(), false);
+
+        for (const auto& material : model.materials)
+        {
+            const int32_t textureIndex = material.normalTexture.index;
+
+            if (textureIndex >= 0 && model.textures[textureIndex].source >= 0)
+            {
+                normalMaps[model.textures[textureIndex].source] = true;
+            }
+        }
+
+        std::vector<CompressedTexture> compressedTextures(model.images.size());
+
+        ThreadHelpers::ParallelFor(model.images.size(), threadCount, [&](size_t i)
+            {
+                const tinygltf::Image& image = model.images[i];
+
+                const vk::Extent2D extent = VulkanHelpers::GetExtent(image.width, image.height);
+                const uint32_t componentCount = static_cast<uint32_t>(image.component);
+
+                CompressedTexture& compressedTexture = compressedTextures[i];
+                compressedTexture.format = GetCompressedFormat(image, normalMaps[i]);
+                compressedTexture.mipLevels.reserve(mipLevels[i].size() + 1);
+
+                compressedTexture.mipLevels.push_back(TextureCompression::Compress(
+                        compressedTexture.format, ByteView(image.image), extent, componentCount));
+
+                for (uint32_t j = 0; j < mipLevels[i].size(); ++j)
+                {
+                    const vk::Extent2D mipLevelExtent = ImageHelpers::CalculateMipLevelExtent(extent, j + 1);
+
+                    compressedTexture.mipLevels.push_back(TextureCompression::Compress(
+                            compressedTexture.format, ByteView(mipLevels[i][j]), mipLevelExtent, componentCount));
+                }
+            });
+
+        size_t originalSize = 0;
+        size_t compressedSize = 0;
+
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            originalSize += model.images[i].image.size();
+
+            for (const auto& mipLevel : mipLevels[i])
+            {
+                originalSize += mipLevel.size();
+            }
+
+            for (const auto& mipLevel : compressedTextures[i].mipLevels)
+            {
+                compressedSize += mipLevel.size();
+            }
+        }
+
+        LogI << Format("Scene textures compressed: %.2f MB -> %.2f MB in %.2f ms",
+                static_cast<float>(originalSize) / static_cast<float>(Numbers::kMegabyte),
+                static_cast<float>(compressedSize) / static_cast<float>(Numbers::kMegabyte),
+                stopwatch.GetElapsedMiliseconds()) << "\n";
+
+        return compressedTextures;
+    }
+
+    static std::vector<SceneCache::TextureData> GetCompressedTexturesData(const tinygltf::Model& model,
+            const std::vector<CompressedTexture>& compressedTextures)
+    {
+        std::vector<SceneCache::TextureData> texturesData;
+        texturesData.reserve(compressedTextures.size());
+
+        for (size_t i = 0; i < compressedTextures.size(); ++i)
+        {
+            const tinygltf::Image& image = model.images[i];
+
+            SceneCache::TextureData textureData{
+                compressedTextures[i].format,
+                VulkanHelpers::GetExtent(image.width, image.height),
+                {}
+            };
+
+            for (const auto& mipLevel : compressedTextures[i].mipLevels)
+            {
+                textureData.mipLevels.emplace_back(mipLevel);
+            }
+
+            texturesData.push_back(textureData);
+        }
+
+        return texturesData;
+    }
+
+    static std::optional<uint64_t> GetSourceTimestamp(const Filepath& path)
+    {
+        if (SceneCache::GetCachePath(path) == path || !path.Exists())
+        {
+            return std::nullopt;
+        }
+
+        return path.GetLastWriteTime();
+    }
+
+    static std::string SerializeJson(const tinygltf::Model& model)
+    {
+        tinygltf::Model jsonModel = model;
+
+        for (auto& buffer : jsonModel.buffers)
+        {
+            buffer.data.assign(1, 0);
+            buffer.uri.clear();
+        }
+
+        jsonModel.images.clear();
+
+        std::stringstream stream;
+
+        tinygltf::TinyGLTF writer;
+        const bool result = writer.WriteGltfSceneToStream(&jsonModel, stream, false, false);
+        Assert(result);
+
+        return stream.str();
+    }
+
+    static void BenchmarkImport(const tinygltf::Model& model, const Helpers::ModelBuffers& buffers)
+    {
+        const uint32_t threadCount = ThreadHelpers::GetThreadCount();
+
+        const auto measureDecoding = [&](uint32_t decodingThreadCount)
+            {
+                const Stopwatch stopwatch;
+
+                std::vector<Details::MeshData> meshesData;
+                std::vector<Details::PackedMeshData> packedMeshesData;
+                std::vector<DetailsRT::PrimitiveGeometry> primitivesGeometry;
+
+                DecodePrimitives(model, buffers, decodingThreadCount,
+                        meshesData, packedMeshesData, primitivesGeometry);
+
+                return stopwatch.GetElapsedMiliseconds();
+            };
+
+        const double serialTime = measureDecoding(1);
+        const double parallelTime = measureDecoding(threadCount);
+
+        LogT << "SceneModel import decoding: serial " << serialTime << " ms, "
+                << threadCount << " threads " << parallelTime << " ms, speedup "
+                << serialTime / parallelTime << "x" << std::endl;
+    }
+
+    static void BenchmarkMeshAttributes(const std::vector<SceneCache::PrimitiveData>& primitives)
+    {
+        const uint32_t threadCount = ThreadHelpers::GetThreadCount();
+
+        size_t triangleCount = 0;
+        for (const auto& primitive : primitives)
+        {
+            triangleCount += Details::GetBaseIndices(primitive).size / sizeof(uint32_t) / 3;
+        }
+
+        const auto measureGeneration = [&](uint32_t generationThreadCount)
+            {
+                const Stopwatch stopwatch;
+
+                for (const auto& primitive : primitives)
+                {
+                    const DataView<uint32_t> indices(Details::GetBaseIndices(primitive));
+                    const DataView<glm::vec3> positions(primitive.positions);
+                    const DataView<glm::vec2> texCoords(primitive.texCoords);
+
+                    MeshHelpers::CalculateNormals(indices, positions, generationThreadCount);
+                    MeshHelpers::CalculateTangents(indices, positions, texCoords, generationThreadCount);
+                }
+
+                return static_cast<double>(triangleCount) / (stopwatch.GetElapsedMiliseconds() * Numbers::kMili);
+            };
+
+        const double serialRate = measureGeneration(1);
+        const double parallelRate = measureGeneration(threadCount);
+
+        LogT << "SceneModel normals and tangents generation: " << triangleCount << " triangles, serial "
+                << serialRate * Numbers::kMicro << " Mtris/s, " << threadCount << " threads "
+                << parallelRate * Numbers::kMicro << " Mtris/s" << std::endl;
+    }
+}
+
+struct SceneModel::SceneData
+{
+    std::unique_ptr<MappedFile> cacheFile;
+    std::vector<Details::MeshData> meshesData;
+    std::vector<Details::PackedMeshData> packedMeshesData;
+    std::vector<DetailsRT::PrimitiveGeometry> primitivesGeometry;
+    std::vector<SceneCache::PrimitiveData> primitives;
+    std::vector<SceneCache::TextureData> textures;
+    std::vector<DetailsCache::CompressedTexture> compressedTextures;
+};
+
+struct SceneModel::RayTracingCache
+{
+    DetailsRT::RayTracingData data;
+    std::weak_ptr<const SceneResources> resources;
+};
+
+struct SceneModel::TextureStreaming
+{
+    std::vector<Texture> textures;
+    size_t streamedCount = 0;
+};
+
 SceneModel::SceneModel(const Filepath& path)
 {
+    ScopeTime scopeTime("SceneModel::SceneModel");
+
     model = std::make_unique<tinygltf::Model>();
+    sceneData = std::make_unique<SceneData>();
 
-    tinygltf::TinyGLTF loader;
-    std::string errors;
-    std::string warnings;
+    const Filepath cachePath = SceneCache::GetCachePath(path);
 
-    const bool result = loader.LoadASCIIFromFile(model.get(), &errors, &warnings, path.GetAbsolute());
+    std::optional<SceneCache::Content> content;
 
-    if (!warnings.empty())
+    if (Config::kUseSceneCache && cachePath.Exists())
     {
-        LogW << "Scene loaded with warnings:\n" << warnings;
+        sceneData->cacheFile = MappedFile::Create(cachePath);
+
+        if (sceneData->cacheFile)
+        {
+            content = SceneCache::Read(sceneData->cacheFile->GetData(), DetailsCache::GetSourceTimestamp(path));
+        }
+
+        if (!content.has_value())
+        {
+            Assert(!(path == cachePath));
+
+            LogW << "Scene cache is outdated or invalid, importing " << path.GetAbsolute() << "\n";
+
+            sceneData->cacheFile.reset();
+        }
     }
 
-    if (!errors.empty())
+    if (content.has_value())
     {
-        LogE << "Failed to load scene:\n" << errors;
+        DetailsCache::LoadModel(*model, content->json, path);
+
+        sceneData->primitives = std::move(content->primitives);
+        sceneData->textures = std::move(content->textures);
     }
+    else
+    {
+        const uint32_t threadCount = ThreadHelpers::GetThreadCount();
+
+        const DetailsCache::ModelSource modelSource = DetailsCache::LoadModel(*model, path);
+
+        sceneData->primitives = DetailsCache::DecodePrimitives(*model, modelSource.buffers,
+                threadCount, sceneData->meshesData,
+                sceneData->packedMeshesData, sceneData->primitivesGeometry);
+
+        // Textures get the same mip chain and block compression as a baked cache
+        if constexpr (Config::kTextureCompression != Config::TextureCompression::eNone)
+        {
+            const std::vector<DetailsCache::MipLevels> mipLevels = DetailsCache::GenerateMipLevels(*model, threadCount);
+
+            sceneData->compressedTextures = DetailsCache::CompressTextures(*model, mipLevels, threadCount);
 
-    Assert(result);
+            sceneData->textures = DetailsCache::GetCompressedTexturesData(*model, sceneData->compressedTextures);
+        }
+        else
+        {
+            sceneData->textures = DetailsCache::GetTexturesData(*model, {});
+        }
+
+        if constexpr (Config::kBenchmarkSceneImport)
+        {
+            DetailsCache::BenchmarkImport(*model, modelSource.buffers);
+        }
+    }
+
+    Assert(sceneData->primitives.size() == Details::CollectPrimitives(*model).size());
+    Assert(Details::GetTextureSourceCount(*model) <= sceneData->textures.size());
+
+    if constexpr (Config::kBenchmarkSceneImport)
+    {
+        DetailsCache::BenchmarkMeshAttributes(sceneData->primitives);
+    }
+
+    if constexpr (Config::kStreamSceneTextures)
+    {
+        textureStreaming = std::make_unique<TextureStreaming>();
+        textureStreaming->textures = Details::CreatePlaceholderTextures(*model, sceneData->textures.size());
+    }
 }
 
-SceneModel::~SceneModel() = default;
+SceneModel::~SceneModel()
+{
+    if (textureStreaming)
+    {
+        for (size_t i = 0; i < textureStreaming->streamedCount; ++i)
+        {
+            VulkanContext::textureManager->DestroyTexture(textureStreaming->textures[i]);
+        }
+    }
+}
 
 std::unique_ptr<Scene> SceneModel::CreateScene() const
 {
     ScopeTime scopeTime("SceneModel::CreateScene");
 
-    DetailsRT::RayTracingData rayTracingData;
-    rayTracingData.acceleration = DetailsRT::CreateAccelerationData(*model);
-    rayTracingData.materials = DetailsRT::CreateMaterialsData(*model);
-    rayTracingData.textures = DetailsRT::CreateTexturesData(*model);
-    rayTracingData.geometry = DetailsRT::CreateGeometryData(*model, DetailsRT::kBaseGeometryAttributes);
+    const SharedSceneResources sharedResources = GetRayTracingResources();
 
     const Scene::Hierarchy sceneHierarchy{
-        Details::CreateMeshes(*model),
+        Details::CreateMeshes(sceneData->primitives),
+        Details::CreateMeshlets(sceneData->primitives),
+        Details::CreateMeshLods(sceneData->primitives),
         Details::CreateMaterials(*model),
         Details::CreateRenderObjects(*model),
         Details::CreatePointLights(*model)
     };
 
-    std::vector<vk::Buffer> sceneBuffers = Details::CollectBuffers(sceneHierarchy);
-    std::vector<vk::Buffer> geometryBuffers = std::move(rayTracingData.geometry.buffers);
-    sceneBuffers.insert(sceneBuffers.end(), geometryBuffers.begin(), geometryBuffers.end());
-    sceneBuffers.insert(sceneBuffers.end(), rayTracingData.materials.buffer);
-
     Scene::Resources sceneResources;
-    sceneResources.accelerationStructures = rayTracingData.acceleration.blases;
-    sceneResources.accelerationStructures.push_back(rayTracingData.acceleration.tlas);
-    sceneResources.buffers = std::move(sceneBuffers);
-    sceneResources.samplers = std::move(rayTracingData.textures.samplers);
-    sceneResources.textures = std::move(rayTracingData.textures.textures);
+    sceneResources.buffers = Details::CollectBuffers(sceneHierarchy);
 
-    const DescriptorSet rayTracingDescriptorSet = DetailsRT::CreateDescriptorSet(
-            rayTracingData, vk::ShaderStageFlagBits::eCompute);
+    const DescriptorSet rayTracingDescriptorSet = DetailsRT::CreateDescriptorSet(rayTracingCache->data,
+            DetailsRT::kBaseGeometryAttributes, vk::ShaderStageFlagBits::eCompute);
+
+    const DetailsRT::TexturesData& texturesData = rayTracingCache->data.textures;
 
     const MultiDescriptorSet materialsDescriptorSet = Details::CreateMaterialsDescriptorSet(
-            *model, sceneHierarchy, sceneResources);
+            *model, sceneHierarchy, texturesData.textures, texturesData.samplers);
 
     Scene::DescriptorSets sceneDescriptorSets;
     sceneDescriptorSets.rayTracing = rayTracingDescriptorSet;
@@ -1426,16 +2613,19 @@ std::unique_ptr<Scene> SceneModel::CreateScene() const
     if (!sceneHierarchy.pointLights.empty())
     {
         const vk::Buffer pointLightsBuffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eUniformBuffer, ByteView(sceneHierarchy.pointLights));
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(sceneHierarchy.pointLights));
 
         sceneResources.buffers.push_back(pointLightsBuffer);
 
         sceneDescriptorSets.pointLights = Details::CreatePointLightsDescriptorSet(pointLightsBuffer);
     }
 
+    Details::LogMemoryUsage("Scene", sceneResources);
+
     const Scene::Description sceneDescription{
         sceneHierarchy,
         sceneResources,
+        sharedResources,
         sceneDescriptorSets
     };
 
@@ -1448,51 +2638,42 @@ std::unique_ptr<ScenePT> SceneModel::CreateScenePT() const
 {
     ScopeTime scopeTime("SceneModel::CreateSceneRT");
 
+    const SharedSceneResources sharedResources = GetRayTracingResources();
+
     const std::vector<PointLight> pointLights = Details::CreatePointLights(*model);
 
     const ScenePT::Info sceneInfo{
-        static_cast<uint32_t>(model->materials.size()),
         static_cast<uint32_t>(pointLights.size())
     };
 
-    DetailsRT::RayTracingData rayTracingData;
-    rayTracingData.acceleration = DetailsRT::CreateAccelerationData(*model);
-    rayTracingData.materials = DetailsRT::CreateMaterialsData(*model);
-    rayTracingData.textures = DetailsRT::CreateTexturesData(*model);
-    rayTracingData.geometry = DetailsRT::CreateGeometryData(*model, DetailsRT::kAllGeometryAttributes);
-
     ScenePT::Resources sceneResources;
-    sceneResources.accelerationStructures = std::move(rayTracingData.acceleration.blases);
-    sceneResources.accelerationStructures.push_back(rayTracingData.acceleration.tlas);
-    sceneResources.buffers = std::move(rayTracingData.geometry.buffers);
-    sceneResources.buffers.push_back(rayTracingData.materials.buffer);
-    sceneResources.samplers = std::move(rayTracingData.textures.samplers);
-    sceneResources.textures = std::move(rayTracingData.textures.textures);
 
     const vk::ShaderStageFlags shaderStages = DetailsPT::GetShaderStages();
 
     std::vector<DescriptorSet> descriptorSets{
-        DetailsRT::CreateDescriptorSet(rayTracingData, shaderStages)
+        DetailsRT::CreateDescriptorSet(rayTracingCache->data, DetailsRT::kAllGeometryAttributes, shaderStages)
     };
 
     if (!pointLights.empty())
     {
         const DetailsPT::PointLightsData pointLightsData = DetailsPT::CreatePointLightsData(pointLights);
 
+        sceneResources.accelerationStructures = pointLightsData.accelerationData.blases;
         sceneResources.accelerationStructures.push_back(pointLightsData.accelerationData.tlas);
-        sceneResources.accelerationStructures.insert(sceneResources.accelerationStructures.begin(),
-                pointLightsData.accelerationData.blases.begin(),
-                pointLightsData.accelerationData.blases.end());
 
         sceneResources.buffers.push_back(pointLightsData.pointLightsBuffer);
         sceneResources.buffers.push_back(pointLightsData.colorsBuffer);
+        sceneResources.buffers.push_back(pointLightsData.lightTreeBuffer);
 
         descriptorSets.push_back(DetailsPT::CreatePointLightsDescriptorSet(pointLightsData, shaderStages));
     }
 
+    Details::LogMemoryUsage("ScenePT", sceneResources);
+
     const ScenePT::Description sceneDescription{
         sceneInfo,
         sceneResources,
+        sharedResources,
         descriptorSets
     };
 
@@ -1542,3 +2723,142 @@ std::unique_ptr<Camera> SceneModel::CreateCamera() const
 
     return std::make_unique<Camera>(cameraDescription.value_or(Config::DefaultCamera::kDescription));
 }
+
+SharedSceneResources SceneModel::GetRayTracingResources() const
+{
+    if (rayTracingCache)
+    {
+        const SharedSceneResources sharedResources = rayTracingCache->resources.lock();
+
+        if (sharedResources)
+        {
+            Details::LogMemoryUsage("Shared ray tracing resources reused, saved", *sharedResources);
+
+            return sharedResources;
+        }
+    }
+
+    DetailsRT::RayTracingData rayTracingData;
+    rayTracingData.geometry = DetailsRT::CreateGeometryData(
+            sceneData->primitives, DetailsRT::kBuildGeometryAttributes);
+    rayTracingData.acceleration = DetailsRT::CreateAccelerationData(
+            *model, sceneData->primitives, rayTracingData.geometry);
+    rayTracingData.materials = DetailsRT::CreateMaterialsData(*model);
+    rayTracingData.instances = DetailsRT::CreateInstancesData(*model, sceneData->primitives);
+
+    DetailsRT::DestroyGeometryBuffer(rayTracingData.geometry, DetailsRT::GeometryAttribute::ePositions);
+
+    if (textureStreaming)
+    {
+        rayTracingData.textures = DetailsRT::CreateTexturesData(*model, textureStreaming->textures);
+    }
+    else
+    {
+        rayTracingData.textures = DetailsRT::CreateTexturesData(*model, Details::CreateTextures(sceneData->textures));
+    }
+
+    SceneResources resources;
+    resources.accelerationStructures = rayTracingData.acceleration.blases;
+    resources.accelerationStructures.push_back(rayTracingData.acceleration.tlas);
+
+    for (const auto& [geometryAttribute, buffer] : rayTracingData.geometry.buffers)
+    {
+        resources.buffers.push_back(buffer);
+    }
+
+    resources.buffers.push_back(rayTracingData.materials.buffer);
+    resources.buffers.push_back(rayTracingData.instances.buffer);
+    resources.samplers = rayTracingData.textures.samplers;
+
+    if (!textureStreaming)
+    {
+        resources.textures = rayTracingData.textures.textures;
+    }
+
+    Details::LogMemoryUsage("Shared ray tracing resources", resources);
+
+    const SharedSceneResources sharedResources = SceneHelpers::CreateSharedResources(resources);
+
+    rayTracingCache = std::make_unique<RayTracingCache>(RayTracingCache{ rayTracingData, sharedResources });
+
+    return sharedResources;
+}
+
+bool SceneModel::StreamTextures(const Scene& scene, const ScenePT& scenePT) const
+{
+    if (!textureStreaming || textureStreaming->streamedCount == textureStreaming->textures.size())
+    {
+        return true;
+    }
+
+    std::vector<Texture>& textures = textureStreaming->textures;
+    size_t& streamedCount = textureStreaming->streamedCount;
+
+    const Stopwatch stopwatch;
+
+    do
+    {
+        textures[streamedCount] = Details::CreateTexture(sceneData->textures[streamedCount]);
+
+        ++streamedCount;
+    }
+    while (streamedCount < textures.size()
+            && stopwatch.GetElapsedMiliseconds() * Numbers::kMili < Config::kTextureStreamingTimeBudget);
+
+    DetailsRT::TexturesData& texturesData = rayTracingCache->data.textures;
+    texturesData.textures = textures;
+    texturesData.descriptorInfo = DetailsRT::GetTexturesDescriptorInfo(*model, textures, texturesData.samplers);
+
+    // Texture uploads wait for a fence whose signal covers all earlier submissions on the queue,
+    // so no frame that binds these descriptor sets is still in flight at this point.
+    Details::UpdateMaterialsDescriptorSet(*model, scene.GetHierarchy(),
+            scene.GetDescriptorSets().materials, textures, texturesData.samplers);
+
+    DetailsRT::UpdateTexturesDescriptor(scene.GetDescriptorSets().rayTracing, texturesData.descriptorInfo);
+    DetailsRT::UpdateTexturesDescriptor(scenePT.GetDescriptorSets().front(), texturesData.descriptorInfo);
+
+    return streamedCount == textures.size();
+}
+
+void SceneModel::Bake(const Filepath& scenePath)
+{
+    ScopeTime scopeTime("SceneModel::Bake");
+
+    const uint32_t threadCount = ThreadHelpers::GetThreadCount();
+
+    tinygltf::Model model;
+    const DetailsCache::ModelSource modelSource = DetailsCache::LoadModel(model, scenePath);
+
+    std::vector<Details::MeshData> meshesData;
+    std::vector<Details::PackedMeshData> packedMeshesData;
+    std::vector<DetailsRT::PrimitiveGeometry> primitivesGeometry;
+
+    const std::vector<DetailsCache::MipLevels> mipLevels = DetailsCache::GenerateMipLevels(model, threadCount);
+
+    const std::string json = DetailsCache::SerializeJson(model);
+
+    SceneCache::Content content;
+    content.sourceTimestamp = scenePath.GetLastWriteTime();
+    content.json = ByteView(reinterpret_cast<const uint8_t*>(json.data()), json.size());
+    content.primitives = DetailsCache::DecodePrimitives(model, modelSource.buffers, threadCount,
+            meshesData, packedMeshesData, primitivesGeometry);
+
+    std::vector<DetailsCache::CompressedTexture> compressedTextures;
+
+    if constexpr (Config::kTextureCompression != Config::TextureCompression::eNone)
+    {
+        compressedTextures = DetailsCache::CompressTextures(model, mipLevels, threadCount);
+
+        content.textures = DetailsCache::GetCompressedTexturesData(model, compressedTextures);
+    }
+    else
+    {
+        content.textures = DetailsCache::GetTexturesData(model, mipLevels);
+    }
+
+    const Filepath cachePath = SceneCache::GetCachePath(scenePath);
+
+    SceneCache::Write(cachePath, content);
+
+    LogI << "Scene baked to " << cachePath.GetAbsolute() << "\n";
+}
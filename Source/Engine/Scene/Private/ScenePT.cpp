@@ -13,23 +13,5 @@ ScenePT::~ScenePT()
         DescriptorHelpers::DestroyDescriptorSet(descriptorSet);
     }
 
-    for (const auto& accelerationStructure : description.resources.accelerationStructures)
-    {
-        VulkanContext::accelerationStructureManager->DestroyAccelerationStructure(accelerationStructure);
-    }
-
-    for (const auto& buffer : description.resources.buffers)
-    {
-        VulkanContext::bufferManager->DestroyBuffer(buffer);
-    }
-
-    for (const auto& sampler : description.resources.samplers)
-    {
-        VulkanContext::textureManager->DestroySampler(sampler);
-    }
-
-    for (const auto& texture : description.resources.textures)
-    {
-        VulkanContext::textureManager->DestroyTexture(texture);
-    }
+    SceneHelpers::DestroyResources(description.resources);
 }
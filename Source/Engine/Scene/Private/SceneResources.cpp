@@ -0,0 +1,62 @@
+#include "Engine/Scene/SceneResources.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+
+SharedSceneResources SceneHelpers::CreateSharedResources(const SceneResources& resources)
+{
+    const auto deleter = [](const SceneResources* sharedResources)
+        {
+            DestroyResources(*sharedResources);
+
+            delete sharedResources;
+        };
+
+    return SharedSceneResources(new SceneResources(resources), deleter);
+}
+
+void SceneHelpers::DestroyResources(const SceneResources& resources)
+{
+    for (const auto& accelerationStructure : resources.accelerationStructures)
+    {
+        VulkanContext::accelerationStructureManager->DestroyAccelerationStructure(accelerationStructure);
+    }
+
+    for (const auto& buffer : resources.buffers)
+    {
+        VulkanContext::bufferManager->DestroyBuffer(buffer);
+    }
+
+    for (const auto& sampler : resources.samplers)
+    {
+        VulkanContext::textureManager->DestroySampler(sampler);
+    }
+
+    for (const auto& texture : resources.textures)
+    {
+        VulkanContext::textureManager->DestroyTexture(texture);
+    }
+}
+
+vk::DeviceSize SceneHelpers::CalculateMemorySize(const SceneResources& resources)
+{
+    vk::DeviceSize size = 0;
+
+    for (const auto& accelerationStructure : resources.accelerationStructures)
+    {
+        const vk::Buffer buffer = VulkanContext::accelerationStructureManager->GetStorageBuffer(accelerationStructure);
+
+        size += VulkanContext::memoryManager->GetBufferMemoryBlock(buffer).size;
+    }
+
+    for (const auto& buffer : resources.buffers)
+    {
+        size += VulkanContext::memoryManager->GetBufferMemoryBlock(buffer).size;
+    }
+
+    for (const auto& texture : resources.textures)
+    {
+        size += VulkanContext::memoryManager->GetImageMemoryBlock(texture.image).size;
+    }
+
+    return size;
+}
@@ -0,0 +1,468 @@
+#include "Engine/Scene/TextureCompression.hpp"
+
+#include "Utils/Assert.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kBlockDimension = 4;
+    static constexpr uint32_t kBlockTexelCount = kBlockDimension * kBlockDimension;
+
+    static constexpr uint32_t kPowerIterationCount = 8;
+
+    static constexpr uint32_t kBC7Mode6 = 6;
+
+    static constexpr std::array<uint32_t, 16> kBC7Weights{
+        0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64
+    };
+
+    using Block = std::array<glm::vec4, kBlockTexelCount>;
+
+    class BlockWriter
+    {
+    public:
+        void Write(uint64_t value, uint32_t bitCount)
+        {
+            for (uint32_t i = 0; i < bitCount; ++i, ++offset)
+            {
+                bits[offset / 64] |= ((value >> i) & 1) << (offset % 64);
+            }
+        }
+
+        void Flush(uint8_t* destination, size_t size) const
+        {
+            Assert(offset == size * 8);
+
+            std::memcpy(destination, bits.data(), size);
+        }
+
+    private:
+        std::array<uint64_t, 2> bits{};
+        uint32_t offset = 0;
+    };
+
+    static size_t GetBlockSize(vk::Format format)
+    {
+        switch (format)
+        {
+        case vk::Format::eBc1RgbUnormBlock:
+            return 8;
+        case vk::Format::eBc3UnormBlock:
+        case vk::Format::eBc5UnormBlock:
+        case vk::Format::eBc7UnormBlock:
+            return 16;
+        default:
+            Assert(false);
+            return 0;
+        }
+    }
+
+    static Block FetchBlock(const ByteView& data, const vk::Extent2D& extent,
+            uint32_t componentCount, uint32_t blockX, uint32_t blockY)
+    {
+        Block block;
+
+        for (uint32_t y = 0; y < kBlockDimension; ++y)
+        {
+            for (uint32_t x = 0; x < kBlockDimension; ++x)
+            {
+                const uint32_t texelX = std::min(blockX * kBlockDimension + x, extent.width - 1);
+                const uint32_t texelY = std::min(blockY * kBlockDimension + y, extent.height - 1);
+
+                const uint8_t* texel = data.data
+                        + (static_cast<size_t>(texelY) * extent.width + texelX) * componentCount;
+
+                glm::vec4 color(0.0f, 0.0f, 0.0f, 255.0f);
+                for (uint32_t c = 0; c < componentCount; ++c)
+                {
+                    color[c] = static_cast<float>(texel[c]);
+                }
+
+                block[y * kBlockDimension + x] = color;
+            }
+        }
+
+        return block;
+    }
+
+    template <uint32_t N>
+    static std::pair<glm::vec<N, float>, glm::vec<N, float>> FindPrincipalEndpoints(const Block& block)
+    {
+        using Vec = glm::vec<N, float>;
+
+        Vec mean(0.0f);
+        for (const glm::vec4& texel : block)
+        {
+            mean += Vec(texel);
+        }
+        mean /= static_cast<float>(kBlockTexelCount);
+
+        glm::mat<N, N, float> covariance(0.0f);
+        for (const glm::vec4& texel : block)
+        {
+            const Vec delta = Vec(texel) - mean;
+            covariance += glm::outerProduct(delta, delta);
+        }
+
+        Vec axis(1.0f);
+        for (uint32_t i = 0; i < kPowerIterationCount; ++i)
+        {
+            axis = covariance * axis;
+
+            const float length = glm::length(axis);
+            if (length < std::numeric_limits<float>::epsilon())
+            {
+                return { mean, mean };
+            }
+
+            axis /= length;
+        }
+
+        float minProjection = std::numeric_limits<float>::max();
+        float maxProjection = std::numeric_limits<float>::lowest();
+
+        for (const glm::vec4& texel : block)
+        {
+            const float projection = glm::dot(Vec(texel) - mean, axis);
+
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        const Vec min = glm::clamp(mean + axis * minProjection, Vec(0.0f), Vec(255.0f));
+        const Vec max = glm::clamp(mean + axis * maxProjection, Vec(0.0f), Vec(255.0f));
+
+        return { min, max };
+    }
+
+    static uint16_t PackColor565(const glm::vec3& color)
+    {
+        const uint32_t r = static_cast<uint32_t>(std::round(color.r * 31.0f / 255.0f));
+        const uint32_t g = static_cast<uint32_t>(std::round(color.g * 63.0f / 255.0f));
+        const uint32_t b = static_cast<uint32_t>(std::round(color.b * 31.0f / 255.0f));
+
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    static glm::vec3 UnpackColor565(uint16_t color)
+    {
+        const uint32_t r = (color >> 11) & 31;
+        const uint32_t g = (color >> 5) & 63;
+        const uint32_t b = color & 31;
+
+        return glm::vec3(
+                static_cast<float>((r << 3) | (r >> 2)),
+                static_cast<float>((g << 2) | (g >> 4)),
+                static_cast<float>((b << 3) | (b >> 2)));
+    }
+
+    static void EncodeColorBlock(const Block& block, uint8_t* destination)
+    {
+        const auto [min, max] = FindPrincipalEndpoints<3>(block);
+
+        uint16_t color0 = PackColor565(max);
+        uint16_t color1 = PackColor565(min);
+
+        if (color0 < color1)
+        {
+            std::swap(color0, color1);
+        }
+
+        const glm::vec3 endpoint0 = UnpackColor565(color0);
+        const glm::vec3 endpoint1 = UnpackColor565(color1);
+
+        const std::array<glm::vec3, 4> palette{
+            endpoint0,
+            endpoint1,
+            (2.0f * endpoint0 + endpoint1) / 3.0f,
+            (endpoint0 + 2.0f * endpoint1) / 3.0f
+        };
+
+        uint32_t indices = 0;
+
+        if (color0 != color1)
+        {
+            for (uint32_t i = 0; i < kBlockTexelCount; ++i)
+            {
+                const glm::vec3 texel(block[i]);
+
+                uint32_t bestIndex = 0;
+                float bestError = std::numeric_limits<float>::max();
+
+                for (uint32_t j = 0; j < palette.size(); ++j)
+                {
+                    const glm::vec3 delta = texel - palette[j];
+                    const float error = glm::dot(delta, delta);
+
+                    if (error < bestError)
+                    {
+                        bestIndex = j;
+                        bestError = error;
+                    }
+                }
+
+                indices |= bestIndex << (i * 2);
+            }
+        }
+
+        BlockWriter writer;
+        writer.Write(color0, 16);
+        writer.Write(color1, 16);
+        writer.Write(indices, 32);
+        writer.Flush(destination, 8);
+    }
+
+    static void EncodeChannelBlock(const Block& block, uint32_t channel, uint8_t* destination)
+    {
+        float min = 255.0f;
+        float max = 0.0f;
+
+        for (const glm::vec4& texel : block)
+        {
+            min = std::min(min, texel[channel]);
+            max = std::max(max, texel[channel]);
+        }
+
+        const uint32_t value0 = static_cast<uint32_t>(std::round(max));
+        const uint32_t value1 = static_cast<uint32_t>(std::round(min));
+
+        std::array<float, 8> palette;
+        palette[0] = static_cast<float>(value0);
+        palette[1] = static_cast<float>(value1);
+
+        for (uint32_t i = 1; i < 7; ++i)
+        {
+            palette[i + 1] = static_cast<float>(((7 - i) * value0 + i * value1) / 7);
+        }
+
+        uint64_t indices = 0;
+
+        if (value0 != value1)
+        {
+            for (uint32_t i = 0; i < kBlockTexelCount; ++i)
+            {
+                uint64_t bestIndex = 0;
+                float bestError = std::numeric_limits<float>::max();
+
+                for (uint32_t j = 0; j < palette.size(); ++j)
+                {
+                    const float error = std::abs(block[i][channel] - palette[j]);
+
+                    if (error < bestError)
+                    {
+                        bestIndex = j;
+                        bestError = error;
+                    }
+                }
+
+                indices |= bestIndex << (i * 3);
+            }
+        }
+
+        BlockWriter writer;
+        writer.Write(value0, 8);
+        writer.Write(value1, 8);
+        writer.Write(indices, 48);
+        writer.Flush(destination, 8);
+    }
+
+    static glm::uvec4 QuantizeBC7Endpoint(const glm::vec4& endpoint, uint32_t& pBit)
+    {
+        glm::uvec4 bestQuantized(0);
+        float bestError = std::numeric_limits<float>::max();
+
+        for (uint32_t p = 0; p < 2; ++p)
+        {
+            glm::uvec4 quantized;
+            float error = 0.0f;
+
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                const float value = (endpoint[c] - static_cast<float>(p)) / 2.0f;
+                quantized[c] = static_cast<uint32_t>(std::clamp(std::round(value), 0.0f, 127.0f));
+
+                const float delta = static_cast<float>((quantized[c] << 1) | p) - endpoint[c];
+                error += delta * delta;
+            }
+
+            if (error < bestError)
+            {
+                bestQuantized = quantized;
+                bestError = error;
+                pBit = p;
+            }
+        }
+
+        return bestQuantized;
+    }
+
+    static void EncodeBC7Block(const Block& block, uint8_t* destination)
+    {
+        const auto [min, max] = FindPrincipalEndpoints<4>(block);
+
+        std::array<uint32_t, 2> pBits;
+        std::array<glm::uvec4, 2> endpoints{
+            QuantizeBC7Endpoint(min, pBits[0]),
+            QuantizeBC7Endpoint(max, pBits[1])
+        };
+
+        const auto computePalette = [&]()
+            {
+                const glm::vec4 endpoint0 = glm::vec4((endpoints[0] << 1u) | pBits[0]);
+                const glm::vec4 endpoint1 = glm::vec4((endpoints[1] << 1u) | pBits[1]);
+
+                std::array<glm::vec4, kBC7Weights.size()> palette;
+                for (uint32_t i = 0; i < kBC7Weights.size(); ++i)
+                {
+                    const uint32_t weight = kBC7Weights[i];
+
+                    for (uint32_t c = 0; c < 4; ++c)
+                    {
+                        const uint32_t e0 = static_cast<uint32_t>(endpoint0[c]);
+                        const uint32_t e1 = static_cast<uint32_t>(endpoint1[c]);
+
+                        palette[i][c] = static_cast<float>(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+                    }
+                }
+
+                return palette;
+            };
+
+        const std::array<glm::vec4, kBC7Weights.size()> palette = computePalette();
+
+        std::array<uint32_t, kBlockTexelCount> indices;
+        for (uint32_t i = 0; i < kBlockTexelCount; ++i)
+        {
+            uint32_t bestIndex = 0;
+            float bestError = std::numeric_limits<float>::max();
+
+            for (uint32_t j = 0; j < palette.size(); ++j)
+            {
+                const glm::vec4 delta = block[i] - palette[j];
+                const float error = glm::dot(delta, delta);
+
+                if (error < bestError)
+                {
+                    bestIndex = j;
+                    bestError = error;
+                }
+            }
+
+            indices[i] = bestIndex;
+        }
+
+        if (indices[0] >= kBC7Weights.size() / 2)
+        {
+            std::swap(endpoints[0], endpoints[1]);
+            std::swap(pBits[0], pBits[1]);
+
+            for (uint32_t& index : indices)
+            {
+                index = static_cast<uint32_t>(kBC7Weights.size()) - 1 - index;
+            }
+        }
+
+        BlockWriter writer;
+        writer.Write(1 << kBC7Mode6, kBC7Mode6 + 1);
+
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            writer.Write(endpoints[0][c], 7);
+            writer.Write(endpoints[1][c], 7);
+        }
+
+        writer.Write(pBits[0], 1);
+        writer.Write(pBits[1], 1);
+
+        writer.Write(indices[0], 3);
+        for (uint32_t i = 1; i < kBlockTexelCount; ++i)
+        {
+            writer.Write(indices[i], 4);
+        }
+
+        writer.Flush(destination, 16);
+    }
+
+    static void EncodeBlock(vk::Format format, const Block& block, uint8_t* destination)
+    {
+        switch (format)
+        {
+        case vk::Format::eBc1RgbUnormBlock:
+            EncodeColorBlock(block, destination);
+            break;
+        case vk::Format::eBc3UnormBlock:
+            EncodeChannelBlock(block, 3, destination);
+            EncodeColorBlock(block, destination + 8);
+            break;
+        case vk::Format::eBc5UnormBlock:
+            EncodeChannelBlock(block, 0, destination);
+            EncodeChannelBlock(block, 1, destination + 8);
+            break;
+        case vk::Format::eBc7UnormBlock:
+            EncodeBC7Block(block, destination);
+            break;
+        default:
+            Assert(false);
+            break;
+        }
+    }
+}
+
+bool TextureCompression::IsSupportedFormat(vk::Format format)
+{
+    switch (format)
+    {
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool TextureCompression::HasTransparency(const ByteView& data, uint32_t componentCount)
+{
+    if (componentCount < 4)
+    {
+        return false;
+    }
+
+    for (size_t i = 3; i < data.size; i += componentCount)
+    {
+        if (data.data[i] != std::numeric_limits<uint8_t>::max())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Bytes TextureCompression::Compress(vk::Format format, const ByteView& data,
+        const vk::Extent2D& extent, uint32_t componentCount)
+{
+    Assert(IsSupportedFormat(format));
+    Assert(data.size == static_cast<size_t>(extent.width) * extent.height * componentCount);
+
+    const uint32_t blockCountX = (extent.width + Details::kBlockDimension - 1) / Details::kBlockDimension;
+    const uint32_t blockCountY = (extent.height + Details::kBlockDimension - 1) / Details::kBlockDimension;
+
+    const size_t blockSize = Details::GetBlockSize(format);
+
+    Bytes compressedData(static_cast<size_t>(blockCountX) * blockCountY * blockSize);
+
+    for (uint32_t y = 0; y < blockCountY; ++y)
+    {
+        for (uint32_t x = 0; x < blockCountX; ++x)
+        {
+            const Details::Block block = Details::FetchBlock(data, extent, componentCount, x, y);
+
+            uint8_t* destination = compressedData.data() + (static_cast<size_t>(y) * blockCountX + x) * blockSize;
+
+            Details::EncodeBlock(format, block, destination);
+        }
+    }
+
+    return compressedData;
+}
@@ -1,10 +1,11 @@
 #pragma once
 
+#include "Engine/Scene/SceneResources.hpp"
+#include "Engine/Scene/MeshHelpers.hpp"
 #include "Engine/Render/Vulkan/DescriptorHelpers.hpp"
 #include "Shaders/Common/Common.h"
 
 class Camera;
-struct Texture;
 
 class Scene
 {
@@ -15,10 +16,10 @@ public:
         {
             static const std::vector<vk::Format> kFormat;
 
-            glm::vec3 position;
-            glm::vec3 normal;
-            glm::vec3 tangent;
-            glm::vec2 texCoord;
+            glm::u16vec4 position;
+            uint32_t normal;
+            uint32_t tangent;
+            uint32_t texCoord;
         };
 
         vk::IndexType indexType;
@@ -27,6 +28,15 @@ public:
 
         vk::Buffer vertexBuffer;
         uint32_t vertexCount;
+
+        glm::vec3 positionOffset;
+        glm::vec3 positionScale;
+
+        uint32_t meshletOffset;
+        uint32_t meshletCount;
+
+        uint32_t lodOffset;
+        uint32_t lodCount;
     };
 
     struct PipelineState
@@ -59,21 +69,31 @@ public:
         glm::mat4 transform;
     };
 
+    struct RenderBatch
+    {
+        uint32_t materialIndex;
+        uint32_t meshIndex;
+        uint32_t firstObject;
+        uint32_t objectCount;
+    };
+
+    struct RenderQueue
+    {
+        std::vector<uint32_t> objectIndices;
+        std::vector<RenderBatch> batches;
+    };
+
     struct Hierarchy
     {
         std::vector<Mesh> meshes;
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshLod> lods;
         std::vector<Material> materials;
         std::vector<RenderObject> renderObjects;
         std::vector<PointLight> pointLights;
     };
 
-    struct Resources
-    {
-        std::vector<vk::AccelerationStructureKHR> accelerationStructures;
-        std::vector<vk::Buffer> buffers;
-        std::vector<vk::Sampler> samplers;
-        std::vector<Texture> textures;
-    };
+    using Resources = SceneResources;
 
     struct DescriptorSets
     {
@@ -86,6 +106,7 @@ public:
     {
         Hierarchy hierarchy;
         Resources resources;
+        SharedSceneResources sharedResources;
         DescriptorSets descriptorSets;
     };
 
@@ -97,12 +118,14 @@ public:
 
     const DescriptorSets& GetDescriptorSets() const { return description.descriptorSets; }
 
-    std::vector<RenderObject> GetRenderObjects(uint32_t materialIndex) const;
+    const RenderQueue& GetRenderQueue() const { return renderQueue; }
 
 private:
     Scene(const Description& description_);
 
     Description description;
 
+    RenderQueue renderQueue;
+
     friend class SceneModel;
 };
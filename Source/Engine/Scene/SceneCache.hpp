@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Engine/Filesystem/Filepath.hpp"
+
+#include "Utils/DataHelpers.hpp"
+
+namespace SceneCache
+{
+    struct PrimitiveData
+    {
+        ByteView vertices;
+        ByteView indices;
+        ByteView compactIndices;
+        ByteView positions;
+        ByteView normals;
+        ByteView tangents;
+        ByteView texCoords;
+        ByteView meshlets;
+        ByteView lods;
+        glm::vec3 positionOffset;
+        glm::vec3 positionScale;
+    };
+
+    struct TextureData
+    {
+        vk::Format format;
+        vk::Extent2D extent;
+        std::vector<ByteView> mipLevels;
+    };
+
+    struct Content
+    {
+        uint64_t sourceTimestamp;
+        ByteView json;
+        std::vector<PrimitiveData> primitives;
+        std::vector<TextureData> textures;
+    };
+
+    Filepath GetCachePath(const Filepath& scenePath);
+
+    void Write(const Filepath& path, const Content& content);
+
+    std::optional<Content> Read(const ByteView& data, std::optional<uint64_t> sourceTimestamp);
+}
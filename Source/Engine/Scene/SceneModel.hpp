@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Scene/SceneResources.hpp"
+
 class Filepath;
 class Scene;
 class ScenePT;
@@ -22,6 +24,22 @@ public:
 
     std::unique_ptr<Camera> CreateCamera() const;
 
+    bool StreamTextures(const Scene& scene, const ScenePT& scenePT) const;
+
+    static void Bake(const Filepath& scenePath);
+
 private:
+    struct SceneData;
+    struct RayTracingCache;
+    struct TextureStreaming;
+
     std::unique_ptr<tinygltf::Model> model;
+
+    std::unique_ptr<SceneData> sceneData;
+
+    mutable std::unique_ptr<RayTracingCache> rayTracingCache;
+
+    mutable std::unique_ptr<TextureStreaming> textureStreaming;
+
+    SharedSceneResources GetRayTracingResources() const;
 };
@@ -1,7 +1,7 @@
 #pragma once
 
+#include "Engine/Scene/SceneResources.hpp"
 #include "Engine/Render/Vulkan/DescriptorHelpers.hpp"
-#include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
 
 class Camera;
 class SceneModel;
@@ -11,22 +11,16 @@ class ScenePT
 public:
     struct Info
     {
-        uint32_t materialCount = 0;
         uint32_t pointLightCount = 0;
     };
 
-    struct Resources
-    {
-        std::vector<vk::AccelerationStructureKHR> accelerationStructures;
-        std::vector<vk::Buffer> buffers;
-        std::vector<vk::Sampler> samplers;
-        std::vector<Texture> textures;
-    };
+    using Resources = SceneResources;
 
     struct Description
     {
         Info info;
         Resources resources;
+        SharedSceneResources sharedResources;
         std::vector<DescriptorSet> descriptorSets;
     };
 
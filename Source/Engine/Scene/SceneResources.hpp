@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
+
+struct SceneResources
+{
+    std::vector<vk::AccelerationStructureKHR> accelerationStructures;
+    std::vector<vk::Buffer> buffers;
+    std::vector<vk::Sampler> samplers;
+    std::vector<Texture> textures;
+};
+
+using SharedSceneResources = std::shared_ptr<const SceneResources>;
+
+namespace SceneHelpers
+{
+    SharedSceneResources CreateSharedResources(const SceneResources& resources);
+
+    void DestroyResources(const SceneResources& resources);
+
+    vk::DeviceSize CalculateMemorySize(const SceneResources& resources);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Utils/DataHelpers.hpp"
+
+namespace TextureCompression
+{
+    bool IsSupportedFormat(vk::Format format);
+
+    bool HasTransparency(const ByteView& data, uint32_t componentCount);
+
+    Bytes Compress(vk::Format format, const ByteView& data,
+            const vk::Extent2D& extent, uint32_t componentCount);
+}
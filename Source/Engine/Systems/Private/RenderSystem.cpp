@@ -59,6 +59,16 @@ void RenderSystem::Render(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
     forwardStage->Execute(commandBuffer, imageIndex);
 }
 
+const FrustumCulling::Stats& RenderSystem::GetCullingStats() const
+{
+    return gBufferStage->GetCullingStats();
+}
+
+const GBufferStage::GpuCullingStats& RenderSystem::GetGpuCullingStats() const
+{
+    return gBufferStage->GetGpuCullingStats();
+}
+
 void RenderSystem::SetupGBufferTextures()
 {
     const vk::Extent2D& extent = VulkanContext::swapchain->GetExtent();
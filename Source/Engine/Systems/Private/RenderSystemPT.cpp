@@ -15,18 +15,22 @@ namespace Details
 {
     static constexpr glm::uvec2 kWorkGroupSize(8, 8);
 
+    static std::map<std::string, uint32_t> GetShaderDefines(const ScenePT& scene)
+    {
+        return std::map<std::string, uint32_t>{
+            { "POINT_LIGHT_COUNT", scene.GetInfo().pointLightCount },
+            { "ENVIRONMENT_SAMPLING", static_cast<uint32_t>(Config::kEnvironmentSampling) }
+        };
+    }
+
     static std::unique_ptr<RayTracingPipeline> CreateRayTracingPipeline(const ScenePT& scene,
             const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts)
     {
-        const uint32_t pointLightCount = scene.GetInfo().pointLightCount;
-        const uint32_t materialCount = scene.GetInfo().materialCount;
-
         std::vector<ShaderModule> shaderModules{
             VulkanContext::shaderManager->CreateShaderModule(
                     vk::ShaderStageFlagBits::eRaygenKHR,
                     Filepath("~/Shaders/PathTracing/RayGen.rgen"),
-                    { std::make_pair("POINT_LIGHT_COUNT", pointLightCount) },
-                    std::make_tuple(materialCount)),
+                    GetShaderDefines(scene)),
             VulkanContext::shaderManager->CreateShaderModule(
                     vk::ShaderStageFlagBits::eMissKHR,
                     Filepath("~/Shaders/PathTracing/Miss.rmiss"),
@@ -36,8 +40,7 @@ namespace Details
                     Filepath("~/Shaders/PathTracing/ClosestHit.rchit"), {}),
             VulkanContext::shaderManager->CreateShaderModule(
                     vk::ShaderStageFlagBits::eAnyHitKHR,
-                    Filepath("~/Shaders/PathTracing/AnyHit.rahit"), {},
-                    std::make_tuple(materialCount))
+                    Filepath("~/Shaders/PathTracing/AnyHit.rahit"), {})
         };
 
         std::map<ShaderGroupType, std::vector<ShaderGroup>> shaderGroupsMap;
@@ -59,8 +62,7 @@ namespace Details
                     { std::make_pair("PAYLOAD_LOCATION", 1) }));
             shaderModules.push_back(VulkanContext::shaderManager->CreateShaderModule(
                     vk::ShaderStageFlagBits::eClosestHitKHR,
-                    Filepath("~/Shaders/PathTracing/PointLights.rchit"),
-                    { std::make_pair("POINT_LIGHT_COUNT", pointLightCount) }));
+                    Filepath("~/Shaders/PathTracing/PointLights.rchit"), {}));
             shaderModules.push_back(VulkanContext::shaderManager->CreateShaderModule(
                     vk::ShaderStageFlagBits::eIntersectionKHR,
                     Filepath("~/Shaders/PathTracing/Sphere.rint"), {}));
@@ -93,17 +95,13 @@ namespace Details
     static std::unique_ptr<ComputePipeline> CreateComputePipeline(const ScenePT& scene,
             const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts)
     {
-        const std::pair<std::string, uint32_t> pointLightsDefine{
-            "POINT_LIGHT_COUNT", scene.GetInfo().pointLightCount
-        };
-
         const std::tuple specializationValues = std::make_tuple(
-                kWorkGroupSize.x, kWorkGroupSize.y, 1, scene.GetInfo().materialCount);
+                kWorkGroupSize.x, kWorkGroupSize.y, 1);
 
         const ShaderModule shaderModule = VulkanContext::shaderManager->CreateShaderModule(
                 vk::ShaderStageFlagBits::eCompute,
                 Filepath("~/Shaders/PathTracing/PathTracing.comp"),
-                { pointLightsDefine }, specializationValues);
+                GetShaderDefines(scene), specializationValues);
 
         const vk::PushConstantRange pushConstantRange(
                 vk::ShaderStageFlagBits::eCompute, 0, sizeof(uint32_t));
@@ -334,7 +332,7 @@ void RenderSystemPT::SetupGeneralData()
     generalData.directLightBuffer = BufferHelpers::CreateBufferWithData(
             vk::BufferUsageFlagBits::eUniformBuffer, ByteView(directLight));
 
-    const DescriptorSetDescription descriptorSetDescription{
+    DescriptorSetDescription descriptorSetDescription{
         DescriptorDescription{
             1, vk::DescriptorType::eUniformBuffer,
             Details::GetShaderStages(vk::ShaderStageFlagBits::eRaygenKHR),
@@ -352,12 +350,26 @@ void RenderSystemPT::SetupGeneralData()
         }
     };
 
-    const DescriptorSetData descriptorSetData{
+    DescriptorSetData descriptorSetData{
         DescriptorHelpers::GetData(generalData.cameraBuffer),
         DescriptorHelpers::GetData(generalData.directLightBuffer),
         DescriptorHelpers::GetData(Renderer::defaultSampler, environment->GetTexture().view),
     };
 
+    if constexpr (Config::kEnvironmentSampling)
+    {
+        descriptorSetDescription.push_back(DescriptorDescription{
+            1, vk::DescriptorType::eStorageBuffer,
+            Details::GetShaderStages(vk::ShaderStageFlagBits::eRaygenKHR),
+            vk::DescriptorBindingFlags()
+        });
+
+        descriptorSetData.push_back(DescriptorData{
+            vk::DescriptorType::eStorageBuffer,
+            BufferInfo{ vk::DescriptorBufferInfo(environment->GetAliasTableBuffer(), 0, VK_WHOLE_SIZE) }
+        });
+    }
+
     generalData.descriptorSet = DescriptorHelpers::CreateDescriptorSet(
             descriptorSetDescription, descriptorSetData);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Render/Stages/GBufferStage.hpp"
 #include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
 #include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
 #include "Engine/Systems/System.hpp"
@@ -7,7 +8,6 @@
 class Scene;
 class Camera;
 class Environment;
-class GBufferStage;
 class LightingStage;
 class ForwardStage;
 struct KeyInput;
@@ -23,6 +23,10 @@ public:
 
     void Render(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
 
+    const FrustumCulling::Stats& GetCullingStats() const;
+
+    const GBufferStage::GpuCullingStats& GetGpuCullingStats() const;
+
 private:
     Scene* scene = nullptr;
     Camera* camera = nullptr;
@@ -69,6 +69,13 @@ vec3 WorldToTangent(vec3 v, mat3 TBN)
     return v * TBN;
 }
 
+vec3 DecodeNormalSample(vec2 normalSample)
+{
+    const vec2 xy = normalSample * 2.0 - 1.0;
+
+    return vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0)));
+}
+
 float CosThetaWorld(vec3 N, vec3 v)
 {
     return max(dot(N, v), 0.0);
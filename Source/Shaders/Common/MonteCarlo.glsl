@@ -45,6 +45,24 @@ float CosinePdfHemisphere(float cosTheta)
     return cosTheta * INVERSE_PI;
 }
 
+// Spherical mapping with the poles on the Y axis
+vec3 GetSphericalDirection(vec2 uv)
+{
+    const float phi = 2.0 * PI * uv.x;
+    const float theta = PI * uv.y;
+    const float sinTheta = sin(theta);
+
+    return vec3(sinTheta * cos(phi), cos(theta), sinTheta * sin(phi));
+}
+
+vec2 GetSphericalUV(vec3 direction)
+{
+    const float phi = atan(direction.z, direction.x);
+    const float theta = acos(clamp(direction.y, -1.0, 1.0));
+
+    return vec2(fract(phi * 0.5 * INVERSE_PI + 1.0), theta * INVERSE_PI);
+}
+
 float PowerHeuristic(float pdfA, float pdfB)
 {
     const float f = pdfA * pdfA;
@@ -6,6 +6,7 @@
 #define vec4 glm::vec4
 #define vec3 glm::vec3
 #define vec2 glm::vec2
+#define uint uint32_t
 #endif
 
 struct MaterialRT
@@ -25,11 +26,21 @@ struct MaterialRT
     float alphaCutoff;
 };
 
+// TLAS instances are matched with their records by instance ID,
+// offsets address the primitive inside the shared geometry buffers
+struct InstanceRT
+{
+    uint materialIndex;
+    uint indexOffset;
+    uint vertexOffset;
+};
+
 #ifdef __cplusplus
 #undef mat4
 #undef vec4
 #undef vec3
 #undef vec2
+#undef uint
 #endif
 
 #endif
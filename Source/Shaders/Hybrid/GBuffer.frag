@@ -15,7 +15,7 @@
 #include "Hybrid/Hybrid.h"
 
 layout(push_constant) uniform PushConstants{
-    layout(offset = 64) vec3 cameraPosition;
+    layout(offset = 32) vec3 cameraPosition;
 };
 
 layout(set = 1, binding = 0) uniform sampler2D baseColorTexture;
@@ -57,7 +57,7 @@ void main()
     const vec3 albedo = texture(baseColorTexture, inTexCoord).rgb * material.baseColorFactor.rgb;
 #endif
 
-    vec3 normalSample = texture(normalTexture, inTexCoord).xyz * 2.0 - 1.0;
+    vec3 normalSample = DecodeNormalSample(texture(normalTexture, inTexCoord).xy);
     normalSample = normalize(normalSample * vec3(material.normalScale, material.normalScale, 1.0));
 
 #if DOUBLE_SIDED
@@ -1,17 +1,29 @@
 #version 460
+#extension GL_GOOGLE_include_directive : require
 
 #define SHADER_STAGE vertex
 #pragma shader_stage(vertex)
 
+#define INSTANCE_INDIRECTION 0
+
+#include "Hybrid/Hybrid.h"
+
 layout(push_constant) uniform PushConstants{
-    mat4 transform;
+    vec4 positionOffset;
+    vec4 positionScale;
 };
 
 layout(set = 0, binding = 0) uniform cameraBuffer{ mat4 viewProj; };
 
+layout(set = 2, binding = 0) readonly buffer instancesBuffer{ Instance instances[]; };
+
+#if INSTANCE_INDIRECTION
+layout(set = 2, binding = 1) readonly buffer visibleObjectsBuffer{ uint visibleObjects[]; };
+#endif
+
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
-layout(location = 2) in vec3 inTangent;
+layout(location = 1) in vec2 inNormal;
+layout(location = 2) in vec2 inTangent;
 layout(location = 3) in vec2 inTexCoord;
 
 layout(location = 0) out vec3 outPosition;
@@ -24,13 +36,31 @@ out gl_PerVertex
     vec4 gl_Position;
 };
 
+vec3 DecodeOctahedral(vec2 octahedral)
+{
+    vec3 direction = vec3(octahedral, 1.0 - abs(octahedral.x) - abs(octahedral.y));
+
+    const float t = max(-direction.z, 0.0);
+    direction.x += direction.x >= 0.0 ? -t : t;
+    direction.y += direction.y >= 0.0 ? -t : t;
+
+    return normalize(direction);
+}
+
 void main() 
 {
-    const vec4 worldPosition = transform * vec4(inPosition, 1.0);
+#if INSTANCE_INDIRECTION
+    const mat4 transform = instances[visibleObjects[gl_InstanceIndex]].transform;
+#else
+    const mat4 transform = instances[gl_InstanceIndex].transform;
+#endif
+
+    const vec3 position = positionOffset.xyz + inPosition * positionScale.xyz;
+    const vec4 worldPosition = transform * vec4(position, 1.0);
 
     outPosition = worldPosition.xyz;
-    outNormal = normalize(vec3(transform * vec4(inNormal, 0.0)));
-    outTangent = normalize(vec3(transform * vec4(inTangent, 0.0)));
+    outNormal = normalize(vec3(transform * vec4(DecodeOctahedral(inNormal), 0.0)));
+    outTangent = normalize(vec3(transform * vec4(DecodeOctahedral(inTangent), 0.0)));
     outTexCoord = inTexCoord;
 
     gl_Position = viewProj * worldPosition;
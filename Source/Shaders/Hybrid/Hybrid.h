@@ -4,6 +4,7 @@
 #ifdef __cplusplus
 #define mat4 glm::mat4
 #define vec4 glm::vec4
+#define uint uint32_t
 #endif
 
 struct Material
@@ -16,9 +17,31 @@ struct Material
     float occlusionStrength;
 };
 
+struct MeshletDraw
+{
+    vec4 sphere;
+    vec4 cone;
+    vec4 lodSphere;
+    uint firstIndex;
+    uint indexCount;
+    uint instanceIndex;
+    uint backfaceCulling;
+    uint batchIndex;
+    uint batchDrawOffset;
+    float lodError;
+    float nextLodError;
+};
+
+struct Instance
+{
+    mat4 transform;
+    mat4 inverseTransform;
+};
+
 #ifdef __cplusplus
 #undef mat4
 #undef vec4
+#undef uint
 #endif
 
 #endif
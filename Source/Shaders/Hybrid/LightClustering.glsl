@@ -0,0 +1,29 @@
+#ifndef LIGHT_CLUSTERING_GLSL
+#define LIGHT_CLUSTERING_GLSL
+
+#ifndef SHADER_STAGE
+#define SHADER_STAGE vertex
+#pragma shader_stage(vertex)
+void main() {}
+#endif
+
+#include "Common/Common.glsl"
+
+// Lights are culled at the distance where their irradiance falls below this value
+#define LIGHT_IRRADIANCE_CUTOFF 0.001
+
+float GetLightRadius(vec3 color)
+{
+    return sqrt(Luminance(color) / LIGHT_IRRADIANCE_CUTOFF);
+}
+
+// Inverse square falloff, smoothly windowed to reach zero at the culling radius
+float GetWindowedAttenuation(float distanceSquared, float radius)
+{
+    const float ratio = distanceSquared * Rcp(radius * radius);
+    const float window = Saturate(1.0 - ratio * ratio);
+
+    return window * window * Rcp(distanceSquared);
+}
+
+#endif
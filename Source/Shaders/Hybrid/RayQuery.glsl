@@ -14,26 +14,27 @@ void main() {}
 #include "Common/RayTracing.h"
 #include "Common/RayTracing.glsl"
 
-layout(constant_id = 3) const uint MATERIAL_COUNT = 256;
-
 layout(set = 4, binding = 0) uniform accelerationStructureEXT tlas;
 
-layout(set = 4, binding = 1) uniform materialsBuffer{ MaterialRT materials[MATERIAL_COUNT]; };
-layout(set = 4, binding = 2) uniform sampler2D textures[];
+layout(set = 4, binding = 1) readonly buffer materialsBuffer{ MaterialRT materials[]; };
+layout(set = 4, binding = 2) readonly buffer instancesBuffer{ InstanceRT instances[]; };
+layout(set = 4, binding = 3) uniform sampler2D textures[];
 
-layout(set = 4, binding = 3) readonly buffer IndicesData{ uint indices[]; } indicesData[];
-layout(set = 4, binding = 4) readonly buffer TexCoordsData{ vec2 texCoords[]; } texCoordsData[];
+layout(set = 4, binding = 4) readonly buffer IndicesData{ uint indices[]; } indicesData;
+layout(set = 4, binding = 5) readonly buffer TexCoordsData{ vec2 texCoords[]; } texCoordsData;
 
-uvec3 GetIndices(uint instanceId, uint primitiveId)
+uvec3 GetIndices(InstanceRT instance, uint primitiveId)
 {
-    return uvec3(indicesData[nonuniformEXT(instanceId)].indices[primitiveId * 3 + 0],
-                 indicesData[nonuniformEXT(instanceId)].indices[primitiveId * 3 + 1],
-                 indicesData[nonuniformEXT(instanceId)].indices[primitiveId * 3 + 2]);
+    const uint i = instance.indexOffset + primitiveId * 3;
+
+    return instance.vertexOffset + uvec3(indicesData.indices[i + 0],
+                                         indicesData.indices[i + 1],
+                                         indicesData.indices[i + 2]);
 }
 
-vec2 GetTexCoord(uint instanceId, uint i)
+vec2 GetTexCoord(uint i)
 {
-    return texCoordsData[nonuniformEXT(instanceId)].texCoords[i];
+    return texCoordsData.texCoords[i];
 }
 
 float TraceRay(Ray ray)
@@ -49,24 +50,23 @@ float TraceRay(Ray ray)
     {
         if (rayQueryGetIntersectionTypeEXT(rayQuery, false) == gl_RayQueryCandidateIntersectionTriangleEXT)
         {
-            const uint customIndex = rayQueryGetIntersectionInstanceCustomIndexEXT(rayQuery, false);
+            const uint instanceId = rayQueryGetIntersectionInstanceIdEXT(rayQuery, false);
             const uint primitiveId = rayQueryGetIntersectionPrimitiveIndexEXT(rayQuery, false);
             const vec2 hitCoord = rayQueryGetIntersectionBarycentricsEXT(rayQuery, false);
 
-            const uint instanceId = customIndex & 0x0000FFFF;
-            const uint materialId = customIndex >> 16;
+            const InstanceRT instance = instances[instanceId];
 
-            const uvec3 indices = GetIndices(instanceId, primitiveId);
+            const uvec3 indices = GetIndices(instance, primitiveId);
 
-            const vec2 texCoord0 = GetTexCoord(instanceId, indices[0]);
-            const vec2 texCoord1 = GetTexCoord(instanceId, indices[1]);
-            const vec2 texCoord2 = GetTexCoord(instanceId, indices[2]);
+            const vec2 texCoord0 = GetTexCoord(indices[0]);
+            const vec2 texCoord1 = GetTexCoord(indices[1]);
+            const vec2 texCoord2 = GetTexCoord(indices[2]);
             
             const vec3 baryCoord = vec3(1.0 - hitCoord.x - hitCoord.y, hitCoord.x, hitCoord.y);
 
             const vec2 texCoord = BaryLerp(texCoord0, texCoord1, texCoord2, baryCoord);
 
-            const MaterialRT mat = materials[materialId];
+            const MaterialRT mat = materials[instance.materialIndex];
 
             float alpha = mat.baseColorFactor.a;
             if (mat.baseColorTexture >= 0)
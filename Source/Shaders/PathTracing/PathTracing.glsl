@@ -8,6 +8,7 @@ void main() {}
 #endif
 
 #include "Common/PBR.glsl"
+#include "PathTracing/PathTracing.h"
 
 struct MaterialPayload
 {
@@ -92,4 +93,30 @@ vec3 SampleBSDF(Surface surface, vec3 wo, out vec3 wi, out float pdf, inout uvec
     return EvaluateBSDF(surface, wo, wi, wh);
 }
 
+// Upper bound of the irradiance that lights inside the node bounds can deliver to the point
+float GetLightNodeImportance(LightTreeNode node, vec3 p, vec3 N)
+{
+    const vec3 center = (node.boundsMin + node.boundsMax) * 0.5;
+    const vec3 direction = center - p;
+
+    const float distanceSquared = dot(direction, direction);
+    const float radiusSquared = dot(node.boundsMax - center, node.boundsMax - center);
+
+    if (distanceSquared <= radiusSquared)
+    {
+        return node.power / max(radiusSquared, EPSILON);
+    }
+
+    const float cosTheta = dot(N, direction) * inversesqrt(distanceSquared);
+    const float sinTheta = sqrt(max(1.0 - cosTheta * cosTheta, 0.0));
+
+    const float sinBound = sqrt(radiusSquared / distanceSquared);
+    const float cosBound = sqrt(1.0 - sinBound * sinBound);
+
+    // Cosine of the smallest angle between the normal and a direction towards the bounds
+    const float cosMin = cosTheta >= cosBound ? 1.0 : cosTheta * cosBound + sinTheta * sinBound;
+
+    return node.power * max(cosMin, 0.0) / distanceSquared;
+}
+
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #define vec4 glm::vec4
 #define vec3 glm::vec3
 #define vec2 glm::vec2
+#define uint uint32_t
 #endif
 
 struct CameraPT
@@ -16,11 +17,36 @@ struct CameraPT
     float zFar;
 };
 
+#define LIGHT_TREE_LEAF_BIT 0x80000000u
+
+// Inner nodes store the index of the left child and the right child follows it,
+// leaves store the light index marked with LIGHT_TREE_LEAF_BIT
+struct LightTreeNode
+{
+    vec3 boundsMin;
+    float power;
+    vec3 boundsMax;
+    uint index;
+};
+
+#define ENVIRONMENT_SAMPLING_WIDTH 1024
+#define ENVIRONMENT_SAMPLING_HEIGHT 512
+
+// Alias table entry of an environment texel, pdf is the density over the unit square
+// of the spherical mapping
+struct EnvironmentAliasEntry
+{
+    float probability;
+    uint alias;
+    float pdf;
+};
+
 #ifdef __cplusplus
 #undef mat4
 #undef vec4
 #undef vec3
 #undef vec2
+#undef uint
 #endif
 
 #endif
@@ -0,0 +1,54 @@
+#include <atomic>
+#include <thread>
+
+#include "Utils/ThreadHelpers.hpp"
+
+uint32_t ThreadHelpers::GetThreadCount()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void ThreadHelpers::ParallelFor(size_t count, const IndexFunctor& functor)
+{
+    ParallelFor(count, GetThreadCount(), functor);
+}
+
+void ThreadHelpers::ParallelFor(size_t count, uint32_t threadCount, const IndexFunctor& functor)
+{
+    const size_t workerCount = std::min(static_cast<size_t>(threadCount), count);
+
+    if (workerCount <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            functor(i);
+        }
+
+        return;
+    }
+
+    std::atomic<size_t> nextIndex = 0;
+
+    const auto worker = [&]()
+        {
+            for (size_t i = nextIndex++; i < count; i = nextIndex++)
+            {
+                functor(i);
+            }
+        };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+
+    for (size_t i = 0; i < workerCount - 1; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
@@ -54,6 +54,15 @@ float Timer::GetDeltaSeconds()
     return deltaSeconds;
 }
 
+Stopwatch::Stopwatch()
+    : start(steady_clock::now())
+{}
+
+double Stopwatch::GetElapsedMiliseconds() const
+{
+    return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
 ScopeTime::ScopeTime(const std::string& label_)
     : label(label_)
 {
@@ -0,0 +1,120 @@
+#pragma once
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE2 1
+#endif
+
+namespace SimdHelpers
+{
+#if defined(SIMD_AVX2)
+    using Float = __m256;
+
+    constexpr size_t kWidth = 8;
+
+    inline Float Load(const float* data) { return _mm256_loadu_ps(data); }
+    inline void Store(float* data, Float value) { _mm256_storeu_ps(data, value); }
+    inline Float Set(float value) { return _mm256_set1_ps(value); }
+
+    inline Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    inline Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    inline Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    inline Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+    inline Float Sqrt(Float value) { return _mm256_sqrt_ps(value); }
+
+    inline Float Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    inline Float Equal(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    inline Float Select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+    inline Float And(Float a, Float b) { return _mm256_and_ps(a, b); }
+    inline uint32_t MoveMask(Float mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+
+    inline Float LoadStrided(const float* data, size_t stride)
+    {
+        return _mm256_setr_ps(data[0], data[stride], data[stride * 2], data[stride * 3],
+                data[stride * 4], data[stride * 5], data[stride * 6], data[stride * 7]);
+    }
+
+    inline Float Gather(const float* data, size_t dataStride, const uint32_t* indices, size_t indexStride)
+    {
+        return _mm256_setr_ps(
+                data[indices[0] * dataStride], data[indices[indexStride] * dataStride],
+                data[indices[indexStride * 2] * dataStride], data[indices[indexStride * 3] * dataStride],
+                data[indices[indexStride * 4] * dataStride], data[indices[indexStride * 5] * dataStride],
+                data[indices[indexStride * 6] * dataStride], data[indices[indexStride * 7] * dataStride]);
+    }
+#elif defined(SIMD_SSE2)
+    using Float = __m128;
+
+    constexpr size_t kWidth = 4;
+
+    inline Float Load(const float* data) { return _mm_loadu_ps(data); }
+    inline void Store(float* data, Float value) { _mm_storeu_ps(data, value); }
+    inline Float Set(float value) { return _mm_set1_ps(value); }
+
+    inline Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+    inline Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    inline Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    inline Float Div(Float a, Float b) { return _mm_div_ps(a, b); }
+    inline Float Sqrt(Float value) { return _mm_sqrt_ps(value); }
+
+    inline Float Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+    inline Float Equal(Float a, Float b) { return _mm_cmpeq_ps(a, b); }
+    inline Float Select(Float mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    inline Float And(Float a, Float b) { return _mm_and_ps(a, b); }
+    inline uint32_t MoveMask(Float mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+
+    inline Float LoadStrided(const float* data, size_t stride)
+    {
+        return _mm_setr_ps(data[0], data[stride], data[stride * 2], data[stride * 3]);
+    }
+
+    inline Float Gather(const float* data, size_t dataStride, const uint32_t* indices, size_t indexStride)
+    {
+        return _mm_setr_ps(
+                data[indices[0] * dataStride], data[indices[indexStride] * dataStride],
+                data[indices[indexStride * 2] * dataStride], data[indices[indexStride * 3] * dataStride]);
+    }
+#else
+    using Float = float;
+
+    constexpr size_t kWidth = 1;
+
+    inline Float Load(const float* data) { return *data; }
+    inline void Store(float* data, Float value) { *data = value; }
+    inline Float Set(float value) { return value; }
+
+    inline Float Add(Float a, Float b) { return a + b; }
+    inline Float Sub(Float a, Float b) { return a - b; }
+    inline Float Mul(Float a, Float b) { return a * b; }
+    inline Float Div(Float a, Float b) { return a / b; }
+    inline Float Sqrt(Float value) { return std::sqrt(value); }
+
+    inline Float Greater(Float a, Float b) { return a > b ? 1.0f : 0.0f; }
+    inline Float Equal(Float a, Float b) { return a == b ? 1.0f : 0.0f; }
+    inline Float Select(Float mask, Float a, Float b) { return mask != 0.0f ? a : b; }
+    inline Float And(Float a, Float b) { return a != 0.0f && b != 0.0f ? 1.0f : 0.0f; }
+    inline uint32_t MoveMask(Float mask) { return mask != 0.0f ? 1 : 0; }
+
+    inline Float LoadStrided(const float* data, size_t) { return *data; }
+
+    inline Float Gather(const float* data, size_t dataStride, const uint32_t* indices, size_t)
+    {
+        return data[indices[0] * dataStride];
+    }
+#endif
+
+    inline void StoreStrided(float* data, size_t stride, Float value)
+    {
+        alignas(sizeof(Float)) float values[kWidth];
+
+        Store(values, value);
+
+        for (size_t i = 0; i < kWidth; ++i)
+        {
+            data[i * stride] = values[i];
+        }
+    }
+}
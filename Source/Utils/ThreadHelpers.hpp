@@ -0,0 +1,12 @@
+#pragma once
+
+namespace ThreadHelpers
+{
+    using IndexFunctor = std::function<void(size_t)>;
+
+    uint32_t GetThreadCount();
+
+    void ParallelFor(size_t count, const IndexFunctor& functor);
+
+    void ParallelFor(size_t count, uint32_t threadCount, const IndexFunctor& functor);
+}
@@ -15,6 +15,17 @@ private:
     std::optional<TimePoint> lastTimePoint;
 };
 
+class Stopwatch
+{
+public:
+    Stopwatch();
+
+    double GetElapsedMiliseconds() const;
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
 class ScopeTime
 {
 public:
@@ -1,7 +1,16 @@
 #include "Engine/Engine.hpp"
+#include "Engine/Filesystem/Filepath.hpp"
+#include "Engine/Scene/SceneModel.hpp"
 
-int main(int, char**)
+int main(int argc, char* argv[])
 {
+    if (argc >= 3 && std::string(argv[1]) == "--bake")
+    {
+        SceneModel::Bake(Filepath(argv[2]));
+
+        return 0;
+    }
+
     Engine::Create();
 
     Engine::Run();
@@ -26,6 +26,8 @@
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <glm/gtc/packing.hpp>
 
 #pragma warning(pop)
 